@@ -30,6 +30,6 @@ void UToggleTraceNotifyState::SetTraceComponentState(USkeletalMeshComponent* Mes
 	UTraceComponent* TraceComponent = Owner->FindComponentByClass<UTraceComponent>();
 	if (!IsValid(TraceComponent)) return;
 
-	// Set the attacking state
-	TraceComponent->bIsAttacking = bIsAttacking;
+	// Open or close the attack window (also starts or stops the trace tick)
+	TraceComponent->SetAttackWindowActive(bIsAttacking);
 }
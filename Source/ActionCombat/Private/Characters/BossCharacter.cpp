@@ -35,6 +35,8 @@ void ABossCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
+	StatsComp->OnDamageReceivedDelegate.AddDynamic(this, &ABossCharacter::HandleDamageReceived);
+
 	// Cache the AI controller
 	ControllerRef = GetController<AAIController>();
 
@@ -50,7 +52,11 @@ void ABossCharacter::BeginPlay()
 		->GetPawn<AMainCharacter>()
 		->StatsComp->OnZeroHealthDelegate
 		.AddDynamic(this, &ABossCharacter::HandlePlayerDeath);
-	
+}
+
+void ABossCharacter::HandleDamageReceived(FDamageResolution Resolution, AActor* DamageCauser)
+{
+	ReceiveDamageResolved(Resolution, DamageCauser);
 }
 
 // Called every frame
@@ -132,7 +138,7 @@ void ABossCharacter::DetectPawn(APawn* DetectedPawn, APawn* PawnToDetect)
 // Returns boss's strength stat as damage value
 float ABossCharacter::GetDamage()
 {
-	return StatsComp->Stats[EStat::Strength];
+	return StatsComp->GetStat(EStat::Strength);
 }
 
 // Executes a random melee attack
@@ -154,7 +160,7 @@ float ABossCharacter::GetAnimDuration()
 // Returns the melee attack range from stats
 float ABossCharacter::GetMeleeRange()
 {
-	return StatsComp->Stats[EStat::MeleeRange];
+	return StatsComp->GetStat(EStat::MeleeRange);
 }
 
 // Handles logic when player dies (sets AI state to GameOver)
@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/EnemyArchetype.h"
+
+/*
+ *	- Holds the immutable base stats of an enemy kind, shared by all its instances
+ *	- Notifies live instances when it is edited
+ */
+
+#if WITH_EDITOR
+void UEnemyArchetype::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	OnArchetypeChanged.Broadcast();
+}
+#endif
@@ -9,6 +9,7 @@
 #include "Combat/TraceComponent.h"
 #include "Combat/BlockComponent.h"
 #include "Characters/PlayerActionsComponent.h"
+#include "Combat/CombatDamageEvent.h"
 
 /*
  * Implementation of the main playable character
@@ -47,6 +48,8 @@ void AMainCharacter::BeginPlay()
 
     // Get and store reference to the animation instance for later use
     PlayerAnim = Cast<UPlayerAnimInstance>(GetMesh()->GetAnimInstance());
+
+    StatsComp->OnDamageReceivedDelegate.AddDynamic(this, &AMainCharacter::HandleDamageReceived);
 }
 
 // Called every frame
@@ -65,13 +68,13 @@ void AMainCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCompo
 float AMainCharacter::GetDamage()
 {
     // Returns the character's current strength stat as damage value
-    return StatsComp->Stats[EStat::Strength];
+    return StatsComp->GetStat(EStat::Strength);
 }
 
 bool AMainCharacter::HasEnoughStamina(float Cost)
 {
     // Validates if the character has sufficient stamina for an action
-    return StatsComp->Stats[EStat::Stamina] >= Cost;
+    return StatsComp->GetStat(EStat::Stamina) >= Cost;
 }
 
 void AMainCharacter::HandleDeath()
@@ -90,26 +93,8 @@ void AMainCharacter::EndLockOnWithActor(AActor* ActorRef)
 
 bool AMainCharacter::CanTakeDamage(AActor* Opponent)
 {
-    // Invulnerable while rolling
-    if (PlayerActionsComp->bIsRollActive) { return false; }
-    
-    // If blocking, check for parry first
-    if (PlayerAnim->bIsBlocking)
-    {
-        // Check for parry first
-        if (BlockComp->AttemptParry(Opponent))
-        {
-            BlockComp->OnSuccessfulParry(Opponent);
-            return false;
-        }
-        
-        // Return true to allow damage calculation with reduction
-        return true;
-    }
-    
-    // Character can take full damage if not rolling or blocking
-    return true;
-
+    // Blocked hits still land, just with less damage
+    return CheckDefenses(Opponent) == EDamageResult::Applied;
 }
 
 void AMainCharacter::PlayHurtAnim(TSubclassOf<UCameraShakeBase> CameraShakeTemplate)
@@ -117,30 +102,30 @@ void AMainCharacter::PlayHurtAnim(TSubclassOf<UCameraShakeBase> CameraShakeTempl
     // Plays hurt animation and applies camera shake effect if provided
     PlayAnimMontage(HurtAnimMontage);
 
-    if (CameraShakeTemplate)
+    APlayerController* PlayerController{ GetController<APlayerController>() };
+    if (CameraShakeTemplate && PlayerController)
     {
-        GetController<APlayerController>()->ClientStartCameraShake(CameraShakeTemplate);
+        PlayerController->ClientStartCameraShake(CameraShakeTemplate);
     }
 }
 
-float AMainCharacter::CalculateReceivedDamage(float IncomingDamage, AActor* DamageCauser)
+void AMainCharacter::HandleDamageReceived(FDamageResolution Resolution, AActor* DamageCauser)
 {
-    
-    
-    // If blocking and block check returns false (successful block)
-    if (PlayerAnim && PlayerAnim->bIsBlocking)
+    // Only hits that got through hurt, and the death animation isn't cut off
+    if (Resolution.Result == EDamageResult::Applied && StatsComp->GetStat(EStat::Health) > 0.0f)
     {
-        // BlockComp->Check returns false when block is successful
-        if (!BlockComp->Check(DamageCauser))  // Block succeeded
-        {
-            return BlockComp->GetReducedDamage(IncomingDamage);
-        }
+        // The hurt montage cuts off any attack before its reset notify, don't leave its state or buffered presses behind
+        CombatComp->InterruptAttack();
+        PlayHurtAnim(HurtCameraShake);
     }
-    
-    // Return full damage if not blocking or if block failed
-    return IncomingDamage;
 
-    
+    ReceiveDamageResolved(Resolution, DamageCauser);
+}
+
+float AMainCharacter::CalculateReceivedDamage(float IncomingDamage, AActor* DamageCauser)
+{
+    EDamageResult Result{ EDamageResult::Applied };
+    return ApplyBlock(IncomingDamage, DamageCauser, Result);
 }
 
 float AMainCharacter::TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent,
@@ -158,6 +143,62 @@ float AMainCharacter::TakeDamage(float DamageAmount, struct FDamageEvent const&
 
 }
 
+/*
+ * Typed hits go through the same rules as CanTakeDamage + CalculateReceivedDamage, checked once
+ */
+void AMainCharacter::ResolveIncomingDamage(const FCombatDamageEvent& DamageEvent, AActor* Attacker,
+    FDamageResolution& OutResolution)
+{
+    OutResolution.Result = CheckDefenses(Attacker);
+
+    if (OutResolution.Result != EDamageResult::Applied)
+    {
+        OutResolution.FinalDamage = 0.0f;
+        return;
+    }
+
+    OutResolution.FinalDamage = ApplyBlock(OutResolution.FinalDamage, Attacker, OutResolution.Result);
+}
+
+bool AMainCharacter::IsHoldingBlock() const
+{
+    // The anim instance's flag follows the block input, without one the block component's state is used
+    return PlayerAnim ? PlayerAnim->bIsBlocking : BlockComp->IsBlocking();
+}
+
+/*
+ * Rolling evades, blocking right at the start of the parry window parries
+ */
+EDamageResult AMainCharacter::CheckDefenses(AActor* Attacker)
+{
+    // Invulnerable while rolling
+    if (PlayerActionsComp->bIsRollActive) { return EDamageResult::Evaded; }
+
+    // Check for parry first
+    if (IsHoldingBlock() && BlockComp->AttemptParry(Attacker))
+    {
+        BlockComp->OnSuccessfulParry(Attacker);
+        return EDamageResult::Parried;
+    }
+
+    return EDamageResult::Applied;
+}
+
+/*
+ * A well-angled block with enough stamina reduces the damage, a failed one lets all of it through
+ */
+float AMainCharacter::ApplyBlock(float IncomingDamage, AActor* Attacker, EDamageResult& OutResult)
+{
+    // BlockComp->Check returns false when block is successful
+    if (IsHoldingBlock() && !BlockComp->Check(Attacker))
+    {
+        OutResult = EDamageResult::Blocked;
+        return BlockComp->GetReducedDamage(IncomingDamage);
+    }
+
+    return IncomingDamage;
+}
+
 bool AMainCharacter::IsBlocking() const
 {
     if (!BlockComp || !PlayerAnim) return false;
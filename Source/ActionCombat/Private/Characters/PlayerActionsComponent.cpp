@@ -5,6 +5,7 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Interfaces/MainPlayer.h"
+#include "Combat/CombatComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 
 
@@ -32,6 +33,7 @@ void UPlayerActionsComponent::BeginPlay()
 	// Get references to required components and interfaces
 	CharacterRef = GetOwner<ACharacter>();
 	MovementComp = CharacterRef->GetCharacterMovement();
+	CombatComp = CharacterRef->FindComponentByClass<UCombatComponent>();
 
 	// Ensure owner implements the player interface
 	if (!CharacterRef->Implements<UMainPlayer>()) { return; }
@@ -97,7 +99,12 @@ void UPlayerActionsComponent::Walk()
 
 void UPlayerActionsComponent::Roll()
 {
-	if (bIsRollActive || !IPlayerRef->HasEnoughStamina(RollCost)) { return; }
+	if (bIsRollActive) { return; }
+
+	// Mid-attack, the roll starts once the attack reaches its cancel point
+	if (CombatComp && CombatComp->BufferInput(ECombatInput::Roll)) { return; }
+
+	if (!IPlayerRef->HasEnoughStamina(RollCost)) { return; }
 
 	bIsRollActive = true;
 
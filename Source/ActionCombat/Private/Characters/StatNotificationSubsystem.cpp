@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/StatNotificationSubsystem.h"
+#include "Characters/StatsComponent.h"
+#include "Engine/World.h"
+
+/*
+ *	- Collects stats components whose values changed during the frame
+ *	- Has each of them broadcast its final values once at the end of the frame
+ */
+
+DECLARE_CYCLE_STAT(TEXT("Flush Stat Notifications"), STAT_FlushStatNotifications, STATGROUP_Game);
+
+void UStatNotificationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+		this, &UStatNotificationSubsystem::HandleWorldPostActorTick
+	);
+}
+
+void UStatNotificationSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	Super::Deinitialize();
+}
+
+void UStatNotificationSubsystem::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	// The delegate is shared by every world
+	if (World == GetWorld())
+	{
+		Flush();
+	}
+}
+
+void UStatNotificationSubsystem::QueueFlush(UStatsComponent* Component)
+{
+	PendingComponents.Add(Component);
+}
+
+void UStatNotificationSubsystem::Flush()
+{
+	if (PendingComponents.Num() == 0) { return; }
+
+	SCOPE_CYCLE_COUNTER(STAT_FlushStatNotifications);
+
+	// Listeners may change stats again, those changes go into next frame's batch
+	Swap(PendingComponents, FlushingComponents);
+
+	for (const TWeakObjectPtr<UStatsComponent>& Component : FlushingComponents)
+	{
+		if (UStatsComponent* StatsComp{ Component.Get() })
+		{
+			StatsComp->FlushChangeNotifications();
+		}
+	}
+
+	FlushingComponents.Reset();
+}
+
@@ -3,13 +3,17 @@
 
 #include "Characters/StatsComponent.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Interfaces/Fighter.h"
+#include "Characters/StatNotificationSubsystem.h"
+#include "Characters/EnemyArchetype.h"
 
 /*
  *	- Manages character statistics and resources (health, stamina, etc.)
  *  - Handles resource regeneration and reduction
- *  - Controls stamina regeneration timing
+ *  - Controls stamina regeneration timing, ticking only while stamina refills
+ *  - Applies stat modifiers lazily, final values are only recomputed when read after a change
+ *  - Coalesces percent updates so listeners hear about each stat at most once per frame
+ *  - Reads base stats from a shared enemy archetype when one is assigned, keeping only Health and Stamina per instance
  */
 
 // Sets default values for this component's properties
@@ -18,6 +22,9 @@ UStatsComponent::UStatsComponent()
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = true;
+
+	// Only ticks while stamina regenerates
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 
@@ -25,6 +32,66 @@ UStatsComponent::UStatsComponent()
 void UStatsComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	NotificationSubsystem = GetWorld()->GetSubsystem<UStatNotificationSubsystem>();
+
+	// Resources start at the base stats' values
+	CurrentHealth = GetBaseStatBlock()[EStat::Health];
+	CurrentStamina = GetBaseStatBlock()[EStat::Stamina];
+
+#if WITH_EDITOR
+	if (Archetype)
+	{
+		ArchetypeChangedHandle = Archetype->OnArchetypeChanged.AddUObject(
+			this, &UStatsComponent::HandleArchetypeChanged
+		);
+	}
+#endif
+
+	UpdateRegenTick();
+}
+
+
+void UStatsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if WITH_EDITOR
+	if (Archetype)
+	{
+		Archetype->OnArchetypeChanged.Remove(ArchetypeChangedHandle);
+	}
+#endif
+
+	Super::EndPlay(EndPlayReason);
+}
+
+#if WITH_EDITOR
+void UStatsComponent::HandleArchetypeChanged()
+{
+	DirtyStats = ~0u;
+
+	// Max values may have dropped under the current ones
+	HandleMaxStatModified(EStat::MaxHealth);
+	HandleMaxStatModified(EStat::MaxStamina);
+	UpdateRegenTick();
+}
+#endif
+
+
+// Moves values saved in the old TMap<EStat, float> into the stat block
+void UStatsComponent::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	if (Stats_DEPRECATED.Num() == 0) { return; }
+
+	for (const TPair<EStat, float>& Stat : Stats_DEPRECATED)
+	{
+		StatBlock[Stat.Key] = Stat.Value;
+	}
+
+	Stats_DEPRECATED.Empty();
+#endif
 }
 
 
@@ -32,6 +99,22 @@ void UStatsComponent::BeginPlay()
 void UStatsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bCanRegen || !bStaminaRegenEnabled)
+	{
+		UpdateRegenTick();
+		return;
+	}
+
+	// Smoothly regenerate stamina, setting it re-evaluates whether to keep ticking
+	SetStat(EStat::Stamina, UKismetMathLibrary::FInterpTo_Constant(
+		CurrentStamina,
+		GetStat(EStat::MaxStamina),
+		DeltaTime,
+		StaminaRegenRate
+	));
+
+	QueueChangeNotification(EStat::Stamina);
 }
 
 
@@ -40,94 +123,192 @@ void UStatsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActor
  * Will not reduce health if character is already at 0 health
  * Ensures health stays within valid range (0 to MaxHealth)
  */
-void UStatsComponent::ReduceHealth(float Amount, AActor* Opponent)
+void UStatsComponent::ReduceHealth(float Amount, AActor* Opponent, bool bSkipDefenseCheck)
 {
 	// Don't process damage if already dead
-	if (Stats[EStat::Health] <= 0) { return; }
+	if (CurrentHealth <= 0) { return; }
 
 	IFighter* FighterRef{ GetOwner<IFighter>() };
 
-	if (!FighterRef->CanTakeDamage(Opponent)) { return; }
+	if (!bSkipDefenseCheck && !FighterRef->CanTakeDamage(Opponent)) { return; }
 	
 
-	Stats[EStat::Health] -= Amount;
-
 	//Stops Health from going below 0
-	Stats[EStat::Health] = UKismetMathLibrary::FClamp( 
-		Stats[EStat::Health],
+	SetStat(EStat::Health, UKismetMathLibrary::FClamp( 
+		CurrentHealth - Amount,
 		0,
-		Stats[EStat::MaxHealth]
-	);
+		GetStat(EStat::MaxHealth)
+	));
 
-	OnHealthPercentUpdateDelegate.Broadcast(
-		GetStatPercentage(EStat::Health, EStat::MaxHealth)
-		);
-	if (Stats[EStat::Health] == 0)
+	QueueChangeNotification(EStat::Health);
+
+	if (CurrentHealth == 0)
 	{
 		OnZeroHealthDelegate.Broadcast();
 	}
 	
 }
 
+/*
+ * Applies damage from the native damage resolver
+ * Defenses were already checked once by the resolver, so they aren't checked again here
+ */
+void UStatsComponent::ApplyResolvedDamage(const FDamageResolution& Resolution, AActor* DamageCauser)
+{
+	if (Resolution.FinalDamage > 0.0f)
+	{
+		ReduceHealth(Resolution.FinalDamage, DamageCauser, true);
+	}
+
+	OnDamageReceivedDelegate.Broadcast(Resolution, DamageCauser);
+}
+
 /*
  * Reduces character's stamina and starts regeneration delay
  * Clamps stamina between 0 and MaxStamina
- * Sets up delayed regeneration using RetriggerableDelay
+ * Retriggering the regeneration delay only moves its end time forward
  */
 void UStatsComponent::ReduceStamina(float Amount)
 {
 	// Reduce and clamp stamina value
-	Stats[EStat::Stamina] -= Amount;
-	Stats[EStat::Stamina] = UKismetMathLibrary::FClamp( 
-		Stats[EStat::Stamina],
+	SetStat(EStat::Stamina, UKismetMathLibrary::FClamp( 
+		CurrentStamina - Amount,
 		0,
-		Stats[EStat::MaxStamina]
-	);
+		GetStat(EStat::MaxStamina)
+	));
 	
 	// Disable regeneration temporarily
 	bCanRegen = false;
+	UpdateRegenTick();
 
-	// Setup delayed regeneration
-	FLatentActionInfo FunctionInfo{
-		0,
-		100,
-		TEXT("EnableRegen"),
-		this
-	};
-	
-	// Start regeneration delay timer
-	UKismetSystemLibrary::RetriggerableDelay(
-		GetWorld(),
-		StaminaDelayDuration,
-		FunctionInfo
-	);
+	// Push the end of the delay back, the timer is only armed if it isn't already running
+	RegenDelayEndTime = GetWorld()->GetTimeSeconds() + StaminaDelayDuration;
 
-	OnStaminaPercentUpdateDelegate.Broadcast(
-		GetStatPercentage(EStat::Stamina, EStat::MaxStamina)
+	FTimerManager& TimerManager{ GetWorld()->GetTimerManager() };
+	if (!TimerManager.IsTimerActive(RegenDelayTimerHandle))
+	{
+		TimerManager.SetTimer(
+			RegenDelayTimerHandle,
+			this,
+			&UStatsComponent::HandleRegenDelayTimer,
+			FMath::Max(StaminaDelayDuration, KINDA_SMALL_NUMBER),
+			false
 		);
+	}
+
+	QueueChangeNotification(EStat::Stamina);
 	
 }
 
 /*
- * Handles stamina regeneration over time
- * Only regenerates if regeneration is enabled
- * Smoothly interpolates towards maximum stamina
+ * Stamina regeneration runs from the component tick
+ * Left empty so Blueprints that still call this every frame don't regenerate twice
  */
 void UStatsComponent::RegenStamina()
 {
-	// Check if regeneration is allowed
-	if (!bCanRegen) { return; }
-	
-	// Smoothly regenerate stamina
-	Stats[EStat::Stamina] = UKismetMathLibrary::FInterpTo_Constant(
-		Stats[EStat::Stamina],
-		Stats[EStat::MaxStamina],
-		GetWorld()->DeltaTimeSeconds,
-		StaminaRegenRate
-	);
-	OnStaminaPercentUpdateDelegate.Broadcast(GetStatPercentage(
-		EStat::Stamina, EStat::MaxStamina)
+}
+
+void UStatsComponent::SetStaminaRegenEnabled(bool bEnabled)
+{
+	bStaminaRegenEnabled = bEnabled;
+	UpdateRegenTick();
+}
+
+void UStatsComponent::UpdateRegenTick()
+{
+	bool bShouldRegen{
+		bCanRegen &&
+		bStaminaRegenEnabled &&
+		CurrentStamina < GetStat(EStat::MaxStamina)
+	};
+
+	if (IsComponentTickEnabled() != bShouldRegen)
+	{
+		SetComponentTickEnabled(bShouldRegen);
+	}
+}
+
+void UStatsComponent::QueueChangeNotification(EStat Stat)
+{
+	if (Stat == EStat::Health)
+	{
+		bHealthChangePending = true;
+	}
+	else if (Stat == EStat::Stamina)
+	{
+		bStaminaChangePending = true;
+	}
+
+	if (bFlushQueued) { return; }
+
+	// Without the subsystem (e.g. before BeginPlay) there is no frame to wait for
+	if (!NotificationSubsystem)
+	{
+		FlushChangeNotifications();
+		return;
+	}
+
+	bFlushQueued = true;
+	NotificationSubsystem->QueueFlush(this);
+}
+
+/*
+ * Broadcasts the final health and stamina percentages of the frame
+ * Stamina is only broadcast once it moved past the threshold, or reached empty or full
+ */
+void UStatsComponent::FlushChangeNotifications()
+{
+	bFlushQueued = false;
+
+	if (bHealthChangePending)
+	{
+		bHealthChangePending = false;
+
+		float Percent{ GetStatPercentage(EStat::Health, EStat::MaxHealth) };
+		OnHealthPercentUpdateDelegate.Broadcast(Percent);
+		OnStatPercentChangedNative.Broadcast(EStat::Health, Percent);
+	}
+
+	if (bStaminaChangePending)
+	{
+		bStaminaChangePending = false;
+
+		float Percent{ GetStatPercentage(EStat::Stamina, EStat::MaxStamina) };
+
+		bool bReachedLimit{ (Percent <= 0.0f || Percent >= 1.0f) && Percent != LastBroadcastStaminaPercent };
+		if (!bReachedLimit && FMath::Abs(Percent - LastBroadcastStaminaPercent) < StaminaBroadcastThreshold) { return; }
+
+		LastBroadcastStaminaPercent = Percent;
+		OnStaminaPercentUpdateDelegate.Broadcast(Percent);
+		OnStatPercentChangedNative.Broadcast(EStat::Stamina, Percent);
+	}
+}
+
+/*
+ * Fires when the delay that was current when the timer was armed would have ended
+ * Sleeps again for whatever time later spends added on
+ */
+void UStatsComponent::HandleRegenDelayTimer()
+{
+	float RemainingDelay{ GetRegenDelayRemaining() };
+	if (RemainingDelay > 0.0f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(
+			RegenDelayTimerHandle,
+			this,
+			&UStatsComponent::HandleRegenDelayTimer,
+			RemainingDelay,
+			false
 		);
+		return;
+	}
+
+	EnableRegen();
+}
+
+float UStatsComponent::GetRegenDelayRemaining() const
+{
+	return FMath::Max(static_cast<float>(RegenDelayEndTime - GetWorld()->GetTimeSeconds()), 0.0f);
 }
 
 /*
@@ -137,9 +318,234 @@ void UStatsComponent::RegenStamina()
 void UStatsComponent::EnableRegen()
 {
 	bCanRegen = true;
+	UpdateRegenTick();
 }
 
 float UStatsComponent::GetStatPercentage(EStat Current, EStat Max)
 {
-	return (Stats[Current] / Stats[Max]);
+	return (GetStat(Current) / GetStat(Max));
+}
+
+/*
+ * Returns the stat with modifiers applied
+ * Only walks the modifier list if the stat changed since it was last read
+ */
+float UStatsComponent::GetStat(EStat Stat) const
+{
+	// Resources can't be modified, and without modifiers there is nothing cached
+	if (IsResourceStat(Stat)) { return GetResource(Stat); }
+	if (FinalStats.Num() == 0) { return GetBaseStat(Stat); }
+
+	const int32 Index{ StatIndex(Stat) };
+	const uint32 StatBit{ 1u << Index };
+
+	if (DirtyStats & StatBit)
+	{
+		float Additive{ 0.0f };
+		float Multiplier{ 1.0f };
+
+		for (const FStatModifier& Modifier : Modifiers)
+		{
+			if (Modifier.Stat != Stat) { continue; }
+
+			if (Modifier.Op == EStatModifierOp::Additive)
+			{
+				Additive += Modifier.Value;
+			}
+			else
+			{
+				Multiplier *= Modifier.Value;
+			}
+		}
+
+		FinalStats[Index] = (GetBaseStat(Stat) + Additive) * Multiplier;
+		DirtyStats &= ~StatBit;
+	}
+
+	return FinalStats[Index];
+}
+
+void UStatsComponent::MarkStatDirty(EStat Stat)
+{
+	DirtyStats |= 1u << StatIndex(Stat);
+
+	// Spending stamina or raising its max may need regen to start, filling it up stops it
+	if (Stat == EStat::Stamina || Stat == EStat::MaxStamina)
+	{
+		UpdateRegenTick();
+	}
+}
+
+const FStatBlock& UStatsComponent::GetBaseStatBlock() const
+{
+	return Archetype ? Archetype->BaseStats : StatBlock;
+}
+
+float UStatsComponent::GetBaseStat(EStat Stat) const
+{
+	if (IsResourceStat(Stat)) { return GetResource(Stat); }
+
+	return GetBaseStatBlock()[Stat];
+}
+
+void UStatsComponent::SetStat(EStat Stat, float Value)
+{
+	if (IsResourceStat(Stat))
+	{
+		GetResource(Stat) = Value;
+	}
+	else if (Archetype)
+	{
+		// The archetype's value would keep being read, the write would silently do nothing
+		UE_LOG(LogTemp, Warning, TEXT("%s: %s comes from archetype %s, change it with a modifier instead"),
+			*GetOwner()->GetName(), *UEnum::GetValueAsString(Stat), *Archetype->GetName());
+		return;
+	}
+	else
+	{
+		StatBlock[Stat] = Value;
+	}
+
+	MarkStatDirty(Stat);
+}
+
+void UStatsComponent::AddModifier(const FStatModifier& Modifier)
+{
+	// Spending and regen work on the stored resource values, a modifier on them would disagree with GetStat
+	if (IsResourceStat(Modifier.Stat) || Modifier.Stat == EStat::None || StatIndex(Modifier.Stat) >= NumStats)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: modifier from %s can't target %s, modify its max stat instead"),
+			*GetOwner()->GetName(), *Modifier.Source.ToString(), *UEnum::GetValueAsString(Modifier.Stat));
+		return;
+	}
+
+	// First modifier, start caching final values
+	if (FinalStats.Num() == 0)
+	{
+		FinalStats.SetNumUninitialized(NumStats);
+		DirtyStats = ~0u;
+	}
+
+	FStatModifier& AddedModifier{ Modifiers.Add_GetRef(Modifier) };
+	MarkStatDirty(Modifier.Stat);
+	HandleMaxStatModified(Modifier.Stat);
+
+	if (Modifier.Duration <= 0.0f) { return; }
+
+	AddedModifier.ExpireTime = GetWorld()->GetTimeSeconds() + Modifier.Duration;
+	ScheduleModifierExpiry();
+}
+
+int32 UStatsComponent::RemoveModifiersFromSource(FName Source)
+{
+	int32 NumRemoved{ 0 };
+
+	for (int32 Index{ Modifiers.Num() - 1 }; Index >= 0; Index--)
+	{
+		if (Modifiers[Index].Source != Source) { continue; }
+
+		EStat Stat{ Modifiers[Index].Stat };
+		MarkStatDirty(Stat);
+		Modifiers.RemoveAt(Index);
+		HandleMaxStatModified(Stat);
+		NumRemoved++;
+	}
+
+	if (NumRemoved > 0)
+	{
+		ReleaseFinalStatsIfUnmodified();
+		ScheduleModifierExpiry();
+	}
+
+	return NumRemoved;
+}
+
+/*
+ * Points the expiry timer at the earliest timed modifier
+ * Clears it when no timed modifiers are left
+ */
+void UStatsComponent::ScheduleModifierExpiry()
+{
+	double NextExpireTime{ UE_BIG_NUMBER };
+
+	for (const FStatModifier& Modifier : Modifiers)
+	{
+		if (Modifier.Duration > 0.0f)
+		{
+			NextExpireTime = FMath::Min(NextExpireTime, Modifier.ExpireTime);
+		}
+	}
+
+	FTimerManager& TimerManager{ GetWorld()->GetTimerManager() };
+
+	if (NextExpireTime == UE_BIG_NUMBER)
+	{
+		TimerManager.ClearTimer(ModifierExpiryTimerHandle);
+		return;
+	}
+
+	TimerManager.SetTimer(
+		ModifierExpiryTimerHandle,
+		this,
+		&UStatsComponent::HandleModifierExpiry,
+		FMath::Max(static_cast<float>(NextExpireTime - GetWorld()->GetTimeSeconds()), KINDA_SMALL_NUMBER),
+		false
+	);
+}
+
+void UStatsComponent::HandleModifierExpiry()
+{
+	double CurrentTime{ GetWorld()->GetTimeSeconds() };
+
+	for (int32 Index{ Modifiers.Num() - 1 }; Index >= 0; Index--)
+	{
+		const FStatModifier& Modifier{ Modifiers[Index] };
+		if (Modifier.Duration <= 0.0f || Modifier.ExpireTime > CurrentTime) { continue; }
+
+		EStat Stat{ Modifier.Stat };
+		MarkStatDirty(Stat);
+		Modifiers.RemoveAt(Index);
+		HandleMaxStatModified(Stat);
+	}
+
+	ReleaseFinalStatsIfUnmodified();
+	ScheduleModifierExpiry();
+}
+
+// Unmodified stats are read straight from the base stats, the cache isn't needed anymore
+void UStatsComponent::ReleaseFinalStatsIfUnmodified()
+{
+	if (Modifiers.Num() == 0)
+	{
+		FinalStats.Empty();
+	}
+}
+
+/*
+ * Lowering a max stat clamps the current resource down to it
+ * Either way the resource's percentage changed, so it is queued for the UI
+ */
+void UStatsComponent::HandleMaxStatModified(EStat Stat)
+{
+	EStat Resource{ EStat::None };
+	if (Stat == EStat::MaxHealth)
+	{
+		Resource = EStat::Health;
+	}
+	else if (Stat == EStat::MaxStamina)
+	{
+		Resource = EStat::Stamina;
+	}
+	else
+	{
+		return;
+	}
+
+	float MaxValue{ GetStat(Stat) };
+	if (GetResource(Resource) > MaxValue)
+	{
+		SetStat(Resource, MaxValue);
+	}
+
+	QueueChangeNotification(Resource);
 }
@@ -5,6 +5,7 @@
 #include "GameFramework/Character.h"
 #include "interfaces/MainPlayer.h"
 #include "Characters/BossCharacter.h"
+#include "Combat/CombatComponent.h"
 
 // Sets default values for this component's properties
 UBlockComponent::UBlockComponent()
@@ -22,7 +23,7 @@ void UBlockComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// ...
+	CombatComp = GetOwner()->FindComponentByClass<UCombatComponent>();
 	
 }
 
@@ -147,6 +148,9 @@ void UBlockComponent::StartBlocking()
 {
 	if (!bIsBlocking)
 	{
+		// Mid-attack, the block is raised once the attack reaches its cancel point
+		if (CombatComp && CombatComp->BufferInput(ECombatInput::Block)) { return; }
+
 		BlockStartTime = GetWorld()->GetTimeSeconds();
 		bCanParry = true;
 		bInParryWindow = true;
@@ -166,6 +170,12 @@ void UBlockComponent::StartBlocking()
 
 void UBlockComponent::StopBlocking()
 {
+	// Released before the buffered block could start
+	if (CombatComp)
+	{
+		CombatComp->CancelBufferedInput(ECombatInput::Block);
+	}
+
 	bIsBlocking = false;
 	bInParryWindow = false;
 	bCanParry = true;
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/BodyZoneTable.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+/*
+ *	- Compiles authored bone zones into a bone-index-keyed array
+ *	- Resolves the zone of a sweep hit from the physics body it touched
+ */
+
+UBodyZoneTable::UBodyZoneTable()
+{
+	for (float& Multiplier : ZoneMultiplierTable)
+	{
+		Multiplier = 1.0f;
+	}
+}
+
+void UBodyZoneTable::PostLoad()
+{
+	Super::PostLoad();
+
+	if (Mesh)
+	{
+		Mesh->ConditionalPostLoad();
+	}
+
+	Compile();
+}
+
+#if WITH_EDITOR
+void UBodyZoneTable::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Compile();
+}
+#endif
+
+void UBodyZoneTable::Compile()
+{
+	for (int32 ZoneIndex{ 0 }; ZoneIndex < static_cast<int32>(EBodyZone::Count); ZoneIndex++)
+	{
+		const float* Multiplier{ ZoneMultipliers.Find(static_cast<EBodyZone>(ZoneIndex)) };
+		ZoneMultiplierTable[ZoneIndex] = Multiplier ? *Multiplier : 1.0f;
+	}
+
+	BoneIndexToZone.Reset();
+	if (!Mesh) { return; }
+
+	const FReferenceSkeleton& RefSkeleton{ Mesh->GetRefSkeleton() };
+	BoneIndexToZone.SetNumUninitialized(RefSkeleton.GetNum());
+
+	// Parents always come before their children, so each bone can inherit from an already compiled parent
+	for (int32 BoneIndex{ 0 }; BoneIndex < RefSkeleton.GetNum(); BoneIndex++)
+	{
+		if (const EBodyZone* Zone{ BoneZones.Find(RefSkeleton.GetBoneName(BoneIndex)) })
+		{
+			BoneIndexToZone[BoneIndex] = *Zone;
+			continue;
+		}
+
+		int32 ParentIndex{ RefSkeleton.GetParentIndex(BoneIndex) };
+		BoneIndexToZone[BoneIndex] = ParentIndex == INDEX_NONE ? EBodyZone::Default : BoneIndexToZone[ParentIndex];
+	}
+}
+
+EBodyZone UBodyZoneTable::ResolveHitZone(const FHitResult& Hit) const
+{
+	const USkeletalMeshComponent* MeshComp{ Cast<USkeletalMeshComponent>(Hit.GetComponent()) };
+	if (!MeshComp) { return EBodyZone::Default; }
+
+	// For skeletal meshes the hit item is the index of the physics body that was touched
+	if (MeshComp->GetSkeletalMeshAsset() == Mesh && MeshComp->Bodies.IsValidIndex(Hit.Item))
+	{
+		const FBodyInstance* Body{ MeshComp->Bodies[Hit.Item] };
+		if (Body && BoneIndexToZone.IsValidIndex(Body->InstanceBoneIndex))
+		{
+			return BoneIndexToZone[Body->InstanceBoneIndex];
+		}
+	}
+
+	// Different mesh on a shared skeleton, fall back to looking the bone up by name
+	if (Mesh && Hit.BoneName != NAME_None)
+	{
+		int32 BoneIndex{ Mesh->GetRefSkeleton().FindBoneIndex(Hit.BoneName) };
+		if (BoneIndexToZone.IsValidIndex(BoneIndex))
+		{
+			return BoneIndexToZone[BoneIndex];
+		}
+	}
+
+	return EBodyZone::Default;
+}
@@ -5,7 +5,11 @@
 #include "GameFramework/Character.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Interfaces/MainPlayer.h"
+#include "Combat/LockOnComponent.h"
+#include "Combat/BlockComponent.h"
+#include "Characters/PlayerActionsComponent.h"
 
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Input To Montage Latency (ms)"), STAT_InputToMontageLatency, STATGROUP_Game);
 
 // Sets default values for this component's properties
 UCombatComponent::UCombatComponent()
@@ -14,7 +18,8 @@ UCombatComponent::UCombatComponent()
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = true;
 
-	// ...
+	// Only ticks while turning toward a soft target
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 
@@ -25,6 +30,9 @@ void UCombatComponent::BeginPlay()
 	Super::BeginPlay();
 
 	CharacterRef = GetOwner<ACharacter>();
+	LockOnComp = GetOwner()->FindComponentByClass<ULockOnComponent>();
+	PlayerActionsComp = GetOwner()->FindComponentByClass<UPlayerActionsComponent>();
+	BlockComp = GetOwner()->FindComponentByClass<UBlockComponent>();
 	
 }
 
@@ -35,11 +43,58 @@ void UCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// ...
+	AActor* Target{ SoftTarget.Get() };
+	SoftTargetTurnTimeRemaining -= DeltaTime;
+
+	// Windup is over or the target is gone
+	if (!IsValid(Target) || SoftTargetTurnTimeRemaining <= 0.0f)
+	{
+		SoftTarget = nullptr;
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	// Turn toward the target on the yaw axis only
+	FRotator CurrentRotation{ CharacterRef->GetActorRotation() };
+	FRotator DesiredRotation{ CurrentRotation };
+	DesiredRotation.Yaw = (Target->GetActorLocation() - CharacterRef->GetActorLocation()).Rotation().Yaw;
+
+	CharacterRef->SetActorRotation(
+		FMath::RInterpTo(CurrentRotation, DesiredRotation, DeltaTime, SoftTargetTurnSpeed)
+	);
 }
 
 void UCombatComponent::ComboAttack()
 {
+	ComboAttackWithInput(EComboInput::Light, false);
+}
+
+void UCombatComponent::ComboAttackWithInput(EComboInput Input, bool bHeld)
+{
+	EComboInputVariant Variant{ bHeld ? EComboInputVariant::Hold : EComboInputVariant::Tap };
+
+	// Held until the current attack reaches its cancel point instead of being dropped
+	if (BufferInput(ECombatInput::Attack))
+	{
+		BufferedComboInput = Input;
+		BufferedComboVariant = Variant;
+		return;
+	}
+
+	// Pausing after the cancel point before pressing again
+	if (!bHeld && CurrentComboAttack != INDEX_NONE &&
+		GetWorld()->GetTimeSeconds() - CancelPointTime >= DelayedAttackThreshold)
+	{
+		Variant = EComboInputVariant::Delayed;
+	}
+
+	StartComboAttack(Input, Variant, FPlatformTime::Seconds());
+}
+
+void UCombatComponent::StartComboAttack(EComboInput Input, EComboInputVariant Variant, double PressTime, bool bFromBuffer)
+{
+	if (!bCanAttack && !bFromBuffer) { return; }
+
 	if (CharacterRef->Implements<UMainPlayer>())
 	{
 		IMainPlayer* IPlayerRef{ Cast<IMainPlayer>(CharacterRef) };
@@ -49,16 +104,44 @@ void UCombatComponent::ComboAttack()
 			return;
 		}
 	}
-	
-	if (!bCanAttack) { return; }
+
+	UAnimMontage* Montage{ nullptr };
+
+	if (ComboGraph)
+	{
+		// One table read, hold/delay fallbacks and combo restarts are baked in
+		int32 NextAttack{ ComboGraph->GetNextAttack(CurrentComboAttack, Input, Variant) };
+		if (NextAttack == INDEX_NONE) { return; }
+
+		CurrentComboAttack = NextAttack;
+		Montage = ComboGraph->GetAttack(NextAttack).Montage;
+	}
+	else
+	{
+		Montage = AdvanceAttackSequence();
+	}
+
+	if (!Montage) { return; }
 
 	// Clear any existing reset timer when attacking
 	GetWorld()->GetTimerManager().ClearTimer(ComboResetTimerHandle);
 
 	bCanAttack = false;
+
+	AcquireSoftTarget();
 	
-	CharacterRef->PlayAnimMontage(AttackAnimations[ComboCounter]);
+	CharacterRef->PlayAnimMontage(Montage);
+
+	RecordInputLatency(PressTime);
+	
+	OnAttackPerformedDelegate.Broadcast(StaminaCost);
 	
+}
+
+UAnimMontage* UCombatComponent::AdvanceAttackSequence()
+{
+	UAnimMontage* Montage{ AttackAnimations[ComboCounter] };
+
 	ComboCounter++;
 
 	int MaxCombo{ AttackAnimations.Num() };
@@ -68,14 +151,98 @@ void UCombatComponent::ComboAttack()
 		-1,
 		(MaxCombo - 1)
 		);
-	
-	OnAttackPerformedDelegate.Broadcast(StaminaCost);
-	
+
+	return Montage;
+}
+
+bool UCombatComponent::BufferInput(ECombatInput Input)
+{
+	if (bCanAttack || Input == ECombatInput::None) { return false; }
+
+	BufferedInput = Input;
+	BufferedComboInput = EComboInput::Light;
+	BufferedComboVariant = EComboInputVariant::Tap;
+	BufferedInputTime = GetWorld()->GetTimeSeconds();
+	BufferedInputRealTime = FPlatformTime::Seconds();
+
+	return true;
+}
+
+void UCombatComponent::CancelBufferedInput(ECombatInput Input)
+{
+	if (BufferedInput == Input)
+	{
+		BufferedInput = ECombatInput::None;
+	}
+}
+
+void UCombatComponent::ConsumeBufferedInput()
+{
+	ECombatInput Input{ BufferedInput };
+	BufferedInput = ECombatInput::None;
+
+	if (Input == ECombatInput::None) { return; }
+
+	// Stale presses would make the character act long after the player gave up on them
+	if (GetWorld()->GetTimeSeconds() - BufferedInputTime > InputBufferWindow) { return; }
+
+	switch (Input)
+	{
+	case ECombatInput::Attack:
+		StartComboAttack(BufferedComboInput, BufferedComboVariant, BufferedInputRealTime, true);
+		break;
+
+	case ECombatInput::Roll:
+		if (PlayerActionsComp && !PlayerActionsComp->bIsRollActive)
+		{
+			PlayerActionsComp->Roll();
+
+			// Roll can still fail on stamina
+			if (PlayerActionsComp->bIsRollActive)
+			{
+				RecordInputLatency(BufferedInputRealTime);
+			}
+		}
+		break;
+
+	case ECombatInput::Block:
+		if (BlockComp && !BlockComp->IsBlocking())
+		{
+			BlockComp->StartBlocking();
+			RecordInputLatency(BufferedInputRealTime);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UCombatComponent::RecordInputLatency(double PressTime)
+{
+	LastInputLatency = static_cast<float>(FPlatformTime::Seconds() - PressTime);
+
+	SET_FLOAT_STAT(STAT_InputToMontageLatency, LastInputLatency * 1000.0f);
+}
+
+void UCombatComponent::AcquireSoftTarget()
+{
+	// Hard lock-on already aims the character
+	if (!LockOnComp || IsValid(LockOnComp->CurrentTargetActor) || SoftTargetTurnTime <= 0.0f) { return; }
+
+	// Reads the lock-on's cached enemy list, attack spam doesn't add queries
+	AActor* Target{ LockOnComp->FindSoftTarget(SoftTargetRange, SoftTargetConeAngle) };
+	if (!Target) { return; }
+
+	SoftTarget = Target;
+	SoftTargetTurnTimeRemaining = SoftTargetTurnTime;
+	SetComponentTickEnabled(true);
 }
 
 void UCombatComponent::HandleResetAttack()
 {
 	bCanAttack = true;
+	CancelPointTime = GetWorld()->GetTimeSeconds();
 
 	// Add debug message to verify the function is being called
 	//UE_LOG(LogTemp, Warning, TEXT("HandleResetAttack called"));
@@ -90,10 +257,29 @@ void UCombatComponent::HandleResetAttack()
 		false
 	);
 
+	// First point the attack can be cancelled, act on whatever was pressed meanwhile
+	ConsumeBufferedInput();
+
 }
 
 void UCombatComponent::RandomAttack()
 {
+	if (ComboGraph)
+	{
+		// Weighted pick among the attacks that can follow the last one
+		int32 NextAttack{ ComboGraph->PickRandomAttack(CurrentComboAttack) };
+		if (NextAttack == INDEX_NONE || !ComboGraph->GetAttack(NextAttack).Montage)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Combo graph on CombatComponent has no attack to pick"));
+			return;
+		}
+
+		CurrentComboAttack = NextAttack;
+		AnimDuration = CharacterRef
+			->PlayAnimMontage(ComboGraph->GetAttack(NextAttack).Montage);
+		return;
+	}
+
 	if (AttackAnimations.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("No attack animations assigned to CombatComponent"));
@@ -121,8 +307,19 @@ void UCombatComponent::ResetCombo()
 	//UE_LOG(LogTemp, Warning, TEXT("ResetCombo called - Counter was: %d"), ComboCounter);
 
 	ComboCounter = 0;
+	CurrentComboAttack = INDEX_NONE;
 	bCanAttack = true;
 }
 
+void UCombatComponent::InterruptAttack()
+{
+	CharacterRef->StopAnimMontage();
+
+	// The stopped montage won't reach its reset notify
+	GetWorld()->GetTimerManager().ClearTimer(ComboResetTimerHandle);
+	BufferedInput = ECombatInput::None;
+	ResetCombo();
+}
+
 
 
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/CombatHitBatchSubsystem.h"
+#include "Combat/TraceComponent.h"
+#include "Combat/DamageResolver.h"
+
+/*
+ *	- Batches weapon hits per frame
+ *	- Resolves damage through the native damage resolver and plays hit effects in a second pass at the end of the frame
+ */
+
+void UCombatHitBatchSubsystem::QueueHit(FCombatHit&& Hit)
+{
+	PendingHits.Add(MoveTemp(Hit));
+}
+
+void UCombatHitBatchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ResolveHits();
+}
+
+TStatId UCombatHitBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatHitBatchSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatHitBatchSubsystem::ResolveHits()
+{
+	if (PendingHits.Num() == 0) { return; }
+
+	// Swap so hits queued while resolving (e.g. from damage reactions) land in next frame's batch
+	Swap(PendingHits, ResolvingHits);
+	PendingHits.Reset();
+
+	ResolvingHits.RemoveAllSwap([](const FCombatHit& Hit)
+	{
+		return !Hit.Attacker.IsValid() || !Hit.Target.IsValid();
+	});
+
+	// Fixed order independent of which fighter happened to tick first
+	ResolvingHits.Sort([](const FCombatHit& A, const FCombatHit& B)
+	{
+		uint32 AttackerA{ A.Attacker->GetUniqueID() };
+		uint32 AttackerB{ B.Attacker->GetUniqueID() };
+		if (AttackerA != AttackerB) { return AttackerA < AttackerB; }
+
+		return A.Target->GetUniqueID() < B.Target->GetUniqueID();
+	});
+
+	// Pass 1: resolve each hit against the target's defenses and apply the damage
+	FCombatDamageEvent DamageEvent;
+	DamageEvent.CombatDamageType = ECombatDamageType::Melee;
+
+	for (FCombatHit& Hit : ResolvingHits)
+	{
+		Hit.EffectType = EHitEffectType::Normal;
+
+		// An earlier hit in the batch may have killed and destroyed either side
+		AActor* Attacker{ Hit.Attacker.Get() };
+		if (!Attacker || !Hit.Target.IsValid()) { continue; }
+
+		DamageEvent.AttackId = Hit.AttackId;
+		DamageEvent.Damage = Hit.Damage * Hit.ZoneMultiplier;
+		DamageEvent.Zone = Hit.Zone;
+		DamageEvent.HitDirection = Hit.HitDirection;
+		DamageEvent.ImpactPoint = Hit.ImpactPoint;
+		DamageEvent.StatusEffect = Hit.StatusEffect;
+
+		FDamageResolution Resolution{ FDamageResolver::ApplyDamage(Hit.Target.Get(), Attacker, DamageEvent) };
+		Hit.EffectType = Resolution.GetHitEffectType();
+	}
+
+	// Pass 2: hit effects
+	for (const FCombatHit& Hit : ResolvingHits)
+	{
+		if (UTraceComponent* Source{ Hit.Source.Get() })
+		{
+			Source->SpawnHitEffect(Hit.ImpactPoint, Hit.EffectType, Hit.Zone);
+		}
+	}
+
+	ResolvingHits.Reset();
+}
@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/ComboGraph.h"
+
+/*
+ *	- Compiles named attack transitions into a flat attack-index table
+ *	- Bakes hold/delay fallbacks and combo restarts into the table so lookups never branch
+ *	- Keeps per-row cumulative weights for AI picking attacks at random
+ */
+
+void UComboGraph::PostLoad()
+{
+	Super::PostLoad();
+
+	Compile();
+}
+
+#if WITH_EDITOR
+void UComboGraph::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Compile();
+}
+#endif
+
+void UComboGraph::Compile()
+{
+	int32 NumRows{ Attacks.Num() + 1 };
+
+	TMap<FName, int32> AttackIndices;
+	for (int32 AttackIndex{ 0 }; AttackIndex < Attacks.Num(); AttackIndex++)
+	{
+		if (AttackIndices.Contains(Attacks[AttackIndex].Name))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Combo graph %s has more than one attack named %s"), *GetName(), *Attacks[AttackIndex].Name.ToString());
+			continue;
+		}
+
+		AttackIndices.Add(Attacks[AttackIndex].Name, AttackIndex);
+	}
+
+	TransitionTable.Init(INDEX_NONE, NumRows * NumComboInputs);
+
+	auto FillRow{ [&](int32 Row, const TArray<FComboTransition>& Transitions)
+	{
+		int32* RowEntries{ &TransitionTable[Row * NumComboInputs] };
+
+		for (const FComboTransition& Transition : Transitions)
+		{
+			const int32* Next{ AttackIndices.Find(Transition.Next) };
+			if (!Next)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Combo graph %s links to missing attack %s"), *GetName(), *Transition.Next.ToString());
+				continue;
+			}
+
+			RowEntries[GetColumn(Transition.Input, Transition.Variant)] = *Next;
+		}
+
+		// Hold and delayed presses without their own transition act like a tap
+		for (int32 InputIndex{ 0 }; InputIndex < static_cast<int32>(EComboInput::Count); InputIndex++)
+		{
+			EComboInput Input{ static_cast<EComboInput>(InputIndex) };
+			int32 Tap{ RowEntries[GetColumn(Input, EComboInputVariant::Tap)] };
+
+			for (int32 VariantIndex{ 0 }; VariantIndex < static_cast<int32>(EComboInputVariant::Count); VariantIndex++)
+			{
+				int32& Entry{ RowEntries[GetColumn(Input, static_cast<EComboInputVariant>(VariantIndex))] };
+				if (Entry == INDEX_NONE)
+				{
+					Entry = Tap;
+				}
+			}
+		}
+	} };
+
+	FillRow(0, StartTransitions);
+
+	for (int32 AttackIndex{ 0 }; AttackIndex < Attacks.Num(); AttackIndex++)
+	{
+		int32 Row{ GetRow(AttackIndex) };
+		int32* RowEntries{ &TransitionTable[Row * NumComboInputs] };
+
+		if (!Attacks[AttackIndex].bFinisher)
+		{
+			FillRow(Row, Attacks[AttackIndex].Transitions);
+		}
+
+		// Finishers and dead ends start a new combo
+		for (int32 Column{ 0 }; Column < NumComboInputs; Column++)
+		{
+			if (RowEntries[Column] == INDEX_NONE)
+			{
+				RowEntries[Column] = TransitionTable[Column];
+			}
+		}
+	}
+
+	// AI picks among every distinct attack a row can lead to
+	RandomChoiceOffsets.SetNumUninitialized(NumRows + 1);
+	RandomChoices.Reset();
+	RandomCumulativeWeights.Reset();
+
+	for (int32 Row{ 0 }; Row < NumRows; Row++)
+	{
+		int32 RowStart{ RandomChoices.Num() };
+		RandomChoiceOffsets[Row] = RowStart;
+		float TotalWeight{ 0.0f };
+
+		for (int32 Column{ 0 }; Column < NumComboInputs; Column++)
+		{
+			int32 Next{ TransitionTable[Row * NumComboInputs + Column] };
+			if (Next == INDEX_NONE || Attacks[Next].RandomWeight <= 0.0f) { continue; }
+
+			bool bAlreadyAdded{ false };
+			for (int32 ChoiceIndex{ RowStart }; ChoiceIndex < RandomChoices.Num(); ChoiceIndex++)
+			{
+				bAlreadyAdded |= RandomChoices[ChoiceIndex] == Next;
+			}
+			if (bAlreadyAdded) { continue; }
+
+			TotalWeight += Attacks[Next].RandomWeight;
+			RandomChoices.Add(Next);
+			RandomCumulativeWeights.Add(TotalWeight);
+		}
+	}
+
+	RandomChoiceOffsets[NumRows] = RandomChoices.Num();
+}
+
+int32 UComboGraph::PickRandomAttack(int32 AttackIndex) const
+{
+	int32 Row{ GetRow(AttackIndex) };
+	if (!RandomChoiceOffsets.IsValidIndex(Row + 1)) { return INDEX_NONE; }
+
+	// Nothing to follow up with, start a new combo
+	if (RandomChoiceOffsets[Row] == RandomChoiceOffsets[Row + 1])
+	{
+		Row = 0;
+	}
+
+	int32 Start{ RandomChoiceOffsets[Row] };
+	int32 End{ RandomChoiceOffsets[Row + 1] };
+	if (Start == End) { return INDEX_NONE; }
+
+	float Roll{ FMath::FRand() * RandomCumulativeWeights[End - 1] };
+
+	for (int32 ChoiceIndex{ Start }; ChoiceIndex < End - 1; ChoiceIndex++)
+	{
+		if (Roll < RandomCumulativeWeights[ChoiceIndex])
+		{
+			return RandomChoices[ChoiceIndex];
+		}
+	}
+
+	return RandomChoices[End - 1];
+}
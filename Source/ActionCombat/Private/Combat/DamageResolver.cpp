@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/DamageResolver.h"
+#include "Interfaces/Fighter.h"
+#include "Characters/StatsComponent.h"
+#include "Combat/StatusEffectSubsystem.h"
+
+/*
+ *	- Resolves i-frames, parry, block and damage reduction once per hit
+ *	- Applies the final damage directly through the target's stats component
+ *	- Leaves the attack's status effect on targets that didn't defend
+ */
+
+DECLARE_CYCLE_STAT(TEXT("Resolve Damage"), STAT_ResolveDamage, STATGROUP_Game);
+
+FDamageResolution FDamageResolver::ApplyDamage(AActor* Target, AActor* Attacker, const FCombatDamageEvent& DamageEvent)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ResolveDamage);
+
+	FDamageResolution Resolution;
+	Resolution.FinalDamage = DamageEvent.Damage;
+	Resolution.AttackId = DamageEvent.AttackId;
+	Resolution.Zone = DamageEvent.Zone;
+	Resolution.HitDirection = DamageEvent.HitDirection;
+
+	if (!IsValid(Target)) { return Resolution; }
+
+	IFighter* TargetFighter{ Cast<IFighter>(Target) };
+	if (!TargetFighter)
+	{
+		// Props and other non-fighters keep using the engine's damage path
+		Target->TakeDamage(
+			DamageEvent.Damage,
+			DamageEvent,
+			Attacker ? Attacker->GetInstigatorController() : nullptr,
+			Attacker
+		);
+		return Resolution;
+	}
+
+	TargetFighter->ResolveIncomingDamage(DamageEvent, Attacker, Resolution);
+
+	UStatsComponent* StatsComp{ TargetFighter->GetStatsComponent() };
+	if (!StatsComp)
+	{
+		StatsComp = Target->FindComponentByClass<UStatsComponent>();
+	}
+
+	if (StatsComp)
+	{
+		StatsComp->ApplyResolvedDamage(Resolution, Attacker);
+	}
+
+	if (Resolution.Result == EDamageResult::Applied && DamageEvent.StatusEffect.IsSet())
+	{
+		if (UStatusEffectSubsystem* StatusEffects{ Target->GetWorld()->GetSubsystem<UStatusEffectSubsystem>() })
+		{
+			StatusEffects->ApplyStatusEffect(
+				Target,
+				DamageEvent.StatusEffect.Type,
+				DamageEvent.StatusEffect.Duration,
+				DamageEvent.StatusEffect.DamagePerSecond
+			);
+		}
+	}
+
+	return Resolution;
+}
+
+int32 FDamageResolver::NewAttackId()
+{
+	static int32 NextAttackId{ 0 };
+
+	// Wrap before reaching INDEX_NONE
+	NextAttackId = NextAttackId == MAX_int32 ? 0 : NextAttackId + 1;
+	return NextAttackId;
+}
@@ -5,7 +5,8 @@
 #include "Particles/ParticleSystemComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
-#include "Engine/DamageEvents.h"
+#include "Combat/DamageResolver.h"
+#include "Combat/HitEffectPoolSubsystem.h"
 
 
 // Sets default values
@@ -20,7 +21,13 @@ AEnemyProjectile::AEnemyProjectile()
 void AEnemyProjectile::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	// Only the first projectile of a kind creates components, later ones find them pooled
+	UHitEffectPoolSubsystem* EffectPool{ GetWorld()->GetSubsystem<UHitEffectPoolSubsystem>() };
+	if (EffectPool)
+	{
+		EffectPool->Prewarm(EHitEffectType::Normal, HitTemplate, HitEffectPrewarmCount);
+	}
 }
 
 // Called every frame
@@ -37,9 +44,18 @@ void AEnemyProjectile::HandleBeginOverlap(AActor* OtherActor)
     APawn* PawnRef{ Cast<APawn>(OtherActor) };
     if (!PawnRef || !PawnRef->IsPlayerControlled()) { return; }
 
-    // Rest of the existing code...
+    // Hide the projectile's own effect and play the impact from the shared pool
     FindComponentByClass<UParticleSystemComponent>()
-        ->SetTemplate(HitTemplate);
+        ->DeactivateImmediate();
+
+    UHitEffectPoolSubsystem* EffectPool{ GetWorld()->GetSubsystem<UHitEffectPoolSubsystem>() };
+    if (EffectPool)
+    {
+        EffectPool->SpawnEffect(EHitEffectType::Normal, HitTemplate, GetActorLocation(), GetActorRotation());
+    }
+
+    // Read before the projectile is stopped
+    FVector HitDirection{ GetVelocity().GetSafeNormal() };
 
     FindComponentByClass<UProjectileMovementComponent>()
         ->StopMovementImmediately();
@@ -56,14 +72,15 @@ void AEnemyProjectile::HandleBeginOverlap(AActor* OtherActor)
     FindComponentByClass<USphereComponent>()
         ->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     
-    FDamageEvent ProjectileAttackEvent{};
-    
-    PawnRef->TakeDamage(
-        Damage,
-        ProjectileAttackEvent,
-        PawnRef->GetController(),
-        this
-    );
+    FCombatDamageEvent ProjectileAttackEvent;
+    ProjectileAttackEvent.AttackId = FDamageResolver::NewAttackId();
+    ProjectileAttackEvent.Damage = Damage;
+    ProjectileAttackEvent.CombatDamageType = ECombatDamageType::Projectile;
+    ProjectileAttackEvent.HitDirection = HitDirection;
+    ProjectileAttackEvent.ImpactPoint = GetActorLocation();
+    ProjectileAttackEvent.StatusEffect = StatusEffectOnHit;
+
+    FDamageResolver::ApplyDamage(PawnRef, this, ProjectileAttackEvent);
 }
 
 
@@ -3,3 +3,22 @@
 
 #include "Combat/FTraceSockets.h"
 
+FTraceSocketPose FTraceSocketPose::Interpolate(const FTraceSocketPose& From, const FTraceSocketPose& To, float Alpha)
+{
+	FTraceSocketPose Result;
+	Result.Start = FMath::Lerp(From.Start, To.Start, Alpha);
+	Result.Rotation = FQuat::Slerp(From.Rotation, To.Rotation, Alpha);
+
+	FVector FromBlade{ From.End - From.Start };
+	FVector ToBlade{ To.End - To.Start };
+	double BladeLength{ FMath::Lerp(FromBlade.Size(), ToBlade.Size(), static_cast<double>(Alpha)) };
+
+	// Sweep the blade direction along the arc so the tip follows the swing
+	FQuat BladeDelta{ FQuat::FindBetweenVectors(FromBlade, ToBlade) };
+	FVector BladeDirection{
+		FQuat::Slerp(FQuat::Identity, BladeDelta, Alpha).RotateVector(FromBlade.GetSafeNormal())
+	};
+
+	Result.End = Result.Start + BladeDirection * BladeLength;
+	return Result;
+}
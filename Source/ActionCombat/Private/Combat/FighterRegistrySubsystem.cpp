@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/FighterRegistrySubsystem.h"
+#include "Interfaces/Fighter.h"
+#include "Interfaces/Enemy.h"
+#include "EngineUtils.h"
+
+/*
+ *	- Registers every IFighter / IEnemy actor on spawn and unregisters it when its play ends
+ *	- Tracks fighter capsule bounds in a uniform grid
+ *	- Updates cell membership from the root component's transform updates
+ *	- Lets weapon traces skip physics sweeps that can't reach any fighter
+ *	- Answers radius queries for target acquisition without touching physics
+ */
+
+void UFighterRegistrySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for (TActorIterator<AActor> It{ &InWorld }; It; ++It)
+	{
+		RegisterIfFighter(*It);
+	}
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateUObject(this, &UFighterRegistrySubsystem::RegisterIfFighter)
+	);
+}
+
+void UFighterRegistrySubsystem::RegisterIfFighter(AActor* Actor)
+{
+	if (!IsValid(Actor) || !(Actor->Implements<UFighter>() || Actor->Implements<UEnemy>())) { return; }
+
+	RegisterFighter(Actor);
+	Actor->OnEndPlay.AddUniqueDynamic(this, &UFighterRegistrySubsystem::HandleFighterEndPlay);
+}
+
+void UFighterRegistrySubsystem::HandleFighterEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterFighter(Actor);
+}
+
+void UFighterRegistrySubsystem::Deinitialize()
+{
+	if (UWorld* World{ GetWorld() })
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Fighter registry: %d queries, %d rejected, %d cell updates"),
+		Stats.Queries, Stats.Rejected, Stats.CellUpdates);
+
+	for (FFighterEntry& Entry : Fighters)
+	{
+		if (USceneComponent* Root{ Entry.Root.Get() })
+		{
+			Root->TransformUpdated.Remove(Entry.MovedHandle);
+		}
+	}
+
+	Fighters.Empty();
+	ActorToEntry.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UFighterRegistrySubsystem::RegisterFighter(AActor* Fighter)
+{
+	if (!IsValid(Fighter) || ActorToEntry.Contains(Fighter)) { return; }
+
+	USceneComponent* Root{ Fighter->GetRootComponent() };
+	if (!Root) { return; }
+
+	int32 EntryIndex{ Fighters.Add(FFighterEntry{}) };
+	FFighterEntry& Entry{ Fighters[EntryIndex] };
+	Entry.Actor = Fighter;
+	Entry.Root = Root;
+	Entry.Bounds = Root->Bounds.GetBox().ExpandBy(BoundsPadding);
+	Entry.MovedHandle = Root->TransformUpdated.AddUObject(
+		this, &UFighterRegistrySubsystem::HandleFighterMoved, EntryIndex
+	);
+
+	ActorToEntry.Add(Fighter, EntryIndex);
+	AddToCells(EntryIndex);
+}
+
+void UFighterRegistrySubsystem::UnregisterFighter(AActor* Fighter)
+{
+	int32 EntryIndex{ INDEX_NONE };
+	if (!ActorToEntry.RemoveAndCopyValue(Fighter, EntryIndex)) { return; }
+
+	FFighterEntry& Entry{ Fighters[EntryIndex] };
+	if (USceneComponent* Root{ Entry.Root.Get() })
+	{
+		Root->TransformUpdated.Remove(Entry.MovedHandle);
+	}
+
+	RemoveFromCells(EntryIndex);
+	Fighters.RemoveAt(EntryIndex);
+}
+
+bool UFighterRegistrySubsystem::AnyFighterOverlaps(const FBox& Box, const AActor* IgnoredActor) const
+{
+	Stats.Queries++;
+
+	auto Overlaps = [&](const FFighterEntry& Entry)
+	{
+		return Entry.Actor.Get() != IgnoredActor && Entry.Bounds.Intersect(Box);
+	};
+
+	FIntPoint MinCell{ ToCell(Box.Min) };
+	FIntPoint MaxCell{ ToCell(Box.Max) };
+	int32 NumCells{ (MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) };
+
+	if (NumCells > MaxCellsPerQuery)
+	{
+		for (const FFighterEntry& Entry : Fighters)
+		{
+			if (Overlaps(Entry)) { return true; }
+		}
+	}
+	else
+	{
+		for (int32 X{ MinCell.X }; X <= MaxCell.X; X++)
+		{
+			for (int32 Y{ MinCell.Y }; Y <= MaxCell.Y; Y++)
+			{
+				const TArray<int32>* CellEntries{ Cells.Find(FIntPoint{ X, Y }) };
+				if (!CellEntries) { continue; }
+
+				for (int32 EntryIndex : *CellEntries)
+				{
+					if (Overlaps(Fighters[EntryIndex])) { return true; }
+				}
+			}
+		}
+	}
+
+	Stats.Rejected++;
+	return false;
+}
+
+void UFighterRegistrySubsystem::GatherFighters(const FVector& Center, double Radius,
+	TArray<AActor*>& OutFighters, const AActor* IgnoredActor) const
+{
+	const double RadiusSquared{ Radius * Radius };
+
+	auto TryAdd = [&](const FFighterEntry& Entry)
+	{
+		AActor* Actor{ Entry.Actor.Get() };
+		if (!Actor || Actor == IgnoredActor) { return; }
+		if (Entry.Bounds.ComputeSquaredDistanceToPoint(Center) > RadiusSquared) { return; }
+
+		// Fighters spanning several cells are seen once per cell
+		OutFighters.AddUnique(Actor);
+	};
+
+	FBox Box{ Center - FVector{ Radius }, Center + FVector{ Radius } };
+	FIntPoint MinCell{ ToCell(Box.Min) };
+	FIntPoint MaxCell{ ToCell(Box.Max) };
+	int32 NumCells{ (MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) };
+
+	if (NumCells > MaxCellsPerQuery)
+	{
+		for (const FFighterEntry& Entry : Fighters)
+		{
+			TryAdd(Entry);
+		}
+		return;
+	}
+
+	for (int32 X{ MinCell.X }; X <= MaxCell.X; X++)
+	{
+		for (int32 Y{ MinCell.Y }; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<int32>* CellEntries{ Cells.Find(FIntPoint{ X, Y }) };
+			if (!CellEntries) { continue; }
+
+			for (int32 EntryIndex : *CellEntries)
+			{
+				TryAdd(Fighters[EntryIndex]);
+			}
+		}
+	}
+}
+
+FIntPoint UFighterRegistrySubsystem::ToCell(const FVector& Location)
+{
+	return FIntPoint{
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize)
+	};
+}
+
+void UFighterRegistrySubsystem::AddToCells(int32 EntryIndex)
+{
+	FFighterEntry& Entry{ Fighters[EntryIndex] };
+	Entry.MinCell = ToCell(Entry.Bounds.Min);
+	Entry.MaxCell = ToCell(Entry.Bounds.Max);
+
+	for (int32 X{ Entry.MinCell.X }; X <= Entry.MaxCell.X; X++)
+	{
+		for (int32 Y{ Entry.MinCell.Y }; Y <= Entry.MaxCell.Y; Y++)
+		{
+			Cells.FindOrAdd(FIntPoint{ X, Y }).Add(EntryIndex);
+		}
+	}
+}
+
+void UFighterRegistrySubsystem::RemoveFromCells(int32 EntryIndex)
+{
+	const FFighterEntry& Entry{ Fighters[EntryIndex] };
+
+	for (int32 X{ Entry.MinCell.X }; X <= Entry.MaxCell.X; X++)
+	{
+		for (int32 Y{ Entry.MinCell.Y }; Y <= Entry.MaxCell.Y; Y++)
+		{
+			FIntPoint Cell{ X, Y };
+			TArray<int32>* CellEntries{ Cells.Find(Cell) };
+			if (!CellEntries) { continue; }
+
+			CellEntries->RemoveSingleSwap(EntryIndex);
+			if (CellEntries->Num() == 0)
+			{
+				Cells.Remove(Cell);
+			}
+		}
+	}
+}
+
+void UFighterRegistrySubsystem::HandleFighterMoved(USceneComponent* UpdatedComponent,
+	EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 EntryIndex)
+{
+	if (!Fighters.IsValidIndex(EntryIndex)) { return; }
+
+	FFighterEntry& Entry{ Fighters[EntryIndex] };
+	Entry.Bounds = UpdatedComponent->Bounds.GetBox().ExpandBy(BoundsPadding);
+
+	// Most moves stay inside the same cells, only touch the grid when they don't
+	if (ToCell(Entry.Bounds.Min) == Entry.MinCell && ToCell(Entry.Bounds.Max) == Entry.MaxCell) { return; }
+
+	RemoveFromCells(EntryIndex);
+	AddToCells(EntryIndex);
+	Stats.CellUpdates++;
+}
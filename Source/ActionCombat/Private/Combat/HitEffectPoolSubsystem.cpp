@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/HitEffectPoolSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+/*
+ *	- Recycles hit effect particle components instead of spawning auto-destroying emitters
+ *	- Pools are keyed by hit type and template
+ *	- Full pools evict their oldest playing effect
+ */
+
+void UHitEffectPoolSubsystem::Deinitialize()
+{
+	UE_LOG(LogTemp, Log, TEXT("Hit effect pool: %d hits, %d misses, %d evictions, %d components"),
+		Stats.Hits, Stats.Misses, Stats.Evictions, PooledComponents.Num());
+
+	Pools.Empty();
+	ComponentKeys.Empty();
+	PooledComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+void UHitEffectPoolSubsystem::Prewarm(EHitEffectType Type, UParticleSystem* Template, int32 Count)
+{
+	if (!Template || Count <= 0) { return; }
+
+	FPoolKey Key{ Type, Template };
+	FEffectPool& Pool{ FindOrAddPool(Key) };
+	Pool.Capacity = FMath::Max(Pool.Capacity, Count);
+
+	while (Pool.Free.Num() + Pool.Active.Num() < Count)
+	{
+		UParticleSystemComponent* EffectComp{ CreateComponent(Key, Template) };
+		if (!EffectComp) { return; }
+
+		Pool.Free.Add(EffectComp);
+	}
+}
+
+UParticleSystemComponent* UHitEffectPoolSubsystem::SpawnEffect(EHitEffectType Type, UParticleSystem* Template,
+	const FVector& Location, const FRotator& Rotation)
+{
+	if (!Template) { return nullptr; }
+
+	FPoolKey Key{ Type, Template };
+	FEffectPool& Pool{ FindOrAddPool(Key) };
+
+	UParticleSystemComponent* EffectComp{ nullptr };
+
+	if (Pool.Free.Num() > 0)
+	{
+		EffectComp = Pool.Free.Pop(EAllowShrinking::No);
+		Stats.Hits++;
+	}
+	else if (Pool.Active.Num() < Pool.Capacity)
+	{
+		EffectComp = CreateComponent(Key, Template);
+		Stats.Misses++;
+	}
+	else
+	{
+		// Pool is full, cut the oldest effect short and reuse it
+		EffectComp = Pool.Active[0];
+		Pool.Active.RemoveAt(0);
+		EffectComp->DeactivateImmediate();
+		Stats.Evictions++;
+	}
+
+	if (!EffectComp) { return nullptr; }
+
+	EffectComp->SetWorldLocationAndRotation(Location, Rotation);
+	EffectComp->Activate(true);
+	Pool.Active.Add(EffectComp);
+
+	return EffectComp;
+}
+
+UHitEffectPoolSubsystem::FEffectPool& UHitEffectPoolSubsystem::FindOrAddPool(const FPoolKey& Key)
+{
+	FEffectPool* Pool{ Pools.Find(Key) };
+	if (Pool) { return *Pool; }
+
+	FEffectPool& NewPool{ Pools.Add(Key) };
+	NewPool.Capacity = DefaultCapacity;
+	return NewPool;
+}
+
+UParticleSystemComponent* UHitEffectPoolSubsystem::CreateComponent(const FPoolKey& Key, UParticleSystem* Template)
+{
+	// Registered with the world but not auto-destroyed or auto-activated, the pool owns its lifetime
+	UParticleSystemComponent* EffectComp{
+		UGameplayStatics::SpawnEmitterAtLocation(
+			GetWorld(),
+			Template,
+			FTransform::Identity,
+			false,
+			EPSCPoolMethod::None,
+			false
+		)
+	};
+
+	if (!EffectComp) { return nullptr; }
+
+	EffectComp->OnSystemFinished.AddUniqueDynamic(this, &UHitEffectPoolSubsystem::HandleSystemFinished);
+
+	PooledComponents.Add(EffectComp);
+	ComponentKeys.Add(EffectComp, Key);
+
+	return EffectComp;
+}
+
+void UHitEffectPoolSubsystem::HandleSystemFinished(UParticleSystemComponent* FinishedComponent)
+{
+	const FPoolKey* Key{ ComponentKeys.Find(FinishedComponent) };
+	if (!Key) { return; }
+
+	FEffectPool& Pool{ Pools.FindChecked(*Key) };
+
+	// Evicted components were already moved back into play, only return ones still marked active
+	if (Pool.Active.RemoveSingle(FinishedComponent) == 0) { return; }
+
+	Pool.Free.Add(FinishedComponent);
+}
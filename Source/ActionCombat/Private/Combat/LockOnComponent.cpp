@@ -7,13 +7,37 @@
 #include "GameFramework/SpringArmComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Interfaces/Enemy.h"
+#include "Combat/FighterRegistrySubsystem.h"
+#include "Combat/LockOnVisibilitySubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
 
 /**
  * Lock-on component for targeting enemies in combat.
  * Manages detecting, locking onto, and tracking enemies, along with combat state updates.
  * broadcasting target changes for use in UI or animation.
+ * Targets are picked by scoring every enemy in range on distance and view angle,
+ * then line of sight is traced for the best few only.
+ * While locked, a left-to-right list of enemies is refreshed on a timer so switching targets needs no query.
+ * The camera follows the target's aim socket on a critically damped spring and only ticks while locked.
+ * Line of sight to the target is checked asynchronously and the lock-on breaks after it stays blocked for a while.
  */
 
+namespace
+{
+	// Moves an angle toward a target on a critically damped spring, wrapping across +-180 degrees
+	double SpringAngle(double Current, double Target, double& Velocity, float SmoothingTime, float DeltaTime)
+	{
+		const double Omega{ 2.0 / SmoothingTime };
+		const double X{ Omega * DeltaTime };
+		const double Decay{ 1.0 / (1.0 + X + 0.48 * X * X + 0.235 * X * X * X) };
+		const double Change{ FRotator::NormalizeAxis(Current - Target) };
+		const double Temp{ (Velocity + Omega * Change) * DeltaTime };
+
+		Velocity = (Velocity - Omega * Temp) * Decay;
+		return Target + (Change + Temp) * Decay;
+	}
+}
+
 // Sets default values for this component's properties
 ULockOnComponent::ULockOnComponent()
 {
@@ -21,6 +45,9 @@ ULockOnComponent::ULockOnComponent()
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = true;
 
+	// Only ticks while a target is locked
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
 	// ...
 }
 
@@ -35,6 +62,8 @@ void ULockOnComponent::BeginPlay()
 	Controller = GetWorld()->GetFirstPlayerController();
 	MovementComp = OwnerRef->GetCharacterMovement();
 	SpringArmComp = OwnerRef->FindComponentByClass< USpringArmComponent >();
+	FighterRegistry = GetWorld()->GetSubsystem<UFighterRegistrySubsystem>();
+	VisibilitySubsystem = GetWorld()->GetSubsystem<ULockOnVisibilitySubsystem>();
 }
 
 // Called every frame
@@ -42,8 +71,12 @@ void ULockOnComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	//	If there's no valid target, skip
-	if (!IsValid(CurrentTargetActor)) { return; }
+	//	Target was destroyed while locked on, stop ticking and refreshing for it
+	if (!IsValid(CurrentTargetActor))
+	{
+		ReleaseLostTarget();
+		return;
+	}
 
 	//	Get positions of owner and target
 	FVector CurrentLocation = { OwnerRef->GetActorLocation()};
@@ -60,15 +93,28 @@ void ULockOnComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 		EndLockOn();
 		return;
 	}
-	
-	// Slightly adjust the target's location to focus lower
-	TargetLocation.Z -= 125;
 
-	// Calculate rotation needed to face the target
-	FRotator NewRotation{UKismetMathLibrary::FindLookAtRotation(
-	CurrentLocation, TargetLocation	
+	// End lock-on if the target has been hidden behind the level for too long
+	if (bTargetOccluded && GetWorld()->GetTimeSeconds() - OccludedSinceTime >= OcclusionBreakDelay)
+	{
+		EndLockOn();
+		return;
+	}
+	
+	// Calculate rotation needed to face the target's aim point
+	FRotator DesiredRotation{UKismetMathLibrary::FindLookAtRotation(
+	CurrentLocation, GetTargetAimLocation()
 	) };
 
+	// Follow it on a spring so the camera settles without snapping or overshooting
+	FRotator NewRotation{ Controller->GetControlRotation() };
+	NewRotation.Pitch = SpringAngle(
+		NewRotation.Pitch, DesiredRotation.Pitch, CameraRotationVelocity.Pitch, CameraSmoothingTime, DeltaTime
+	);
+	NewRotation.Yaw = SpringAngle(
+		NewRotation.Yaw, DesiredRotation.Yaw, CameraRotationVelocity.Yaw, CameraSmoothingTime, DeltaTime
+	);
+
 	// Apply the new rotation to the controller
 	Controller->SetControlRotation(NewRotation);
 }
@@ -76,34 +122,37 @@ void ULockOnComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 // Starts locking on to the closest valid target within a radius
 void ULockOnComponent::StartLockOn(float Radius)
 {
-	FHitResult OutResult;
-	FVector CurrentLocation { OwnerRef->GetActorLocation() };
-	FCollisionShape Sphere{ FCollisionShape::MakeSphere(Radius) };
-	FCollisionQueryParams IgnoreParams{
-		FName{ TEXT("Ignore Collision Params") },
-		false,
-		OwnerRef
-	};
+	// Pick the best scored enemy the camera can see
+	AActor* BestTarget{ FindBestTarget(Radius) };
 
-	// Perform sphere trace to find enemy
-	bool bHasFoundTarget{ GetWorld()->SweepSingleByChannel(
-		OutResult,
-		CurrentLocation,
-		CurrentLocation,
-		FQuat::Identity,
-		ECollisionChannel::ECC_GameTraceChannel1,
-		Sphere,
-		IgnoreParams
-	) };
+	// If nothing was found, return
+	if (!BestTarget) { return; }
 
-	// If nothing was hit, return
-	if (!bHasFoundTarget) { return; }
+	// Stores the actor as the current target
+	CurrentTargetActor = BestTarget;
+	LockOnRadius = Radius;
+	CacheTargetAimPoint();
 
-	// Make sure the hit actor implements the enemy interface
-	if (!OutResult.GetActor()->Implements<UEnemy>()) { return; }
+	// Start driving the camera
+	CameraRotationVelocity = FRotator::ZeroRotator;
+	SetComponentTickEnabled(true);
 
-	// Stores the actor as the current target
-	CurrentTargetActor = OutResult.GetActor();
+	// Start checking whether the target stays visible
+	bTargetOccluded = false;
+	if (VisibilitySubsystem)
+	{
+		VisibilitySubsystem->AddWatcher(this);
+	}
+
+	// Build the switch list now, then keep it fresh at a low rate
+	RefreshSwitchCandidates();
+	GetWorld()->GetTimerManager().SetTimer(
+		SwitchCandidatesTimerHandle,
+		this,
+		&ULockOnComponent::RefreshSwitchCandidates,
+		SwitchCandidatesRefreshInterval,
+		true
+	);
 
 	// Disable player camera control and configure movement for lock-on
 	// so character rotation is driven by the controller (auto-aimed at the target)
@@ -123,18 +172,132 @@ void ULockOnComponent::StartLockOn(float Radius)
 	// Logs the current Actor selected for debugging to see if lock on works
 	// UE_LOG(
 	// 	LogTemp, Warning, TEXT("Actor Detected: %s"),
-	// 	*OutResult.GetActor()->GetName()
+	// 	*CurrentTargetActor->GetName()
 	// 	);
 	
 }
+bool ULockOnComponent::EvaluateCandidate(FLockOnCandidate& Candidate, const FVector& ViewLocation,
+	const FRotator& ViewRotation, float Radius) const
+{
+	FVector TargetLocation{ Candidate.Actor->GetActorLocation() };
+	FVector ToTarget{ (TargetLocation - ViewLocation).GetSafeNormal() };
+
+	Candidate.ViewAngle = FMath::RadiansToDegrees(
+		FMath::Acos(FMath::Clamp(FVector::DotProduct(ViewRotation.Vector(), ToTarget), -1.0, 1.0))
+	);
+
+	// Ignore enemies too far off screen
+	if (Candidate.ViewAngle > MaxTargetAngle) { return false; }
+
+	Candidate.ScreenYaw = FRotator::NormalizeAxis(ToTarget.Rotation().Yaw - ViewRotation.Yaw);
+	Candidate.Distance = FVector::Distance(OwnerRef->GetActorLocation(), TargetLocation);
+	Candidate.Score =
+		DistanceWeight * (1.0f - FMath::Clamp(Candidate.Distance / Radius, 0.0f, 1.0f)) +
+		AngleWeight * (1.0f - Candidate.ViewAngle / FMath::Max(MaxTargetAngle, KINDA_SMALL_NUMBER));
+
+	return true;
+}
+
+// Scores every enemy within the radius, best first
+void ULockOnComponent::GatherCandidates(float Radius, TArray<FLockOnCandidate>& OutCandidates) const
+{
+	OutCandidates.Reset();
+
+	if (!FighterRegistry) { return; }
+
+	// One grid lookup instead of a physics overlap
+	TArray<AActor*> NearbyFighters;
+	FVector CurrentLocation{ OwnerRef->GetActorLocation() };
+	FighterRegistry->GatherFighters(CurrentLocation, Radius, NearbyFighters, OwnerRef);
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	for (AActor* Fighter : NearbyFighters)
+	{
+		if (!Fighter->Implements<UEnemy>()) { continue; }
+
+		FLockOnCandidate Candidate;
+		Candidate.Actor = Fighter;
+
+		if (EvaluateCandidate(Candidate, ViewLocation, ViewRotation, Radius))
+		{
+			OutCandidates.Add(Candidate);
+		}
+	}
+
+	OutCandidates.Sort([](const FLockOnCandidate& A, const FLockOnCandidate& B)
+	{
+		return A.Score > B.Score;
+	});
+}
+
+// Returns the best scored candidate that isn't hidden behind the level
+AActor* ULockOnComponent::FindBestTarget(float Radius) const
+{
+	TArray<FLockOnCandidate> Candidates;
+	GatherCandidates(Radius, Candidates);
+
+	// Candidates are sorted, so only trace until a visible one is found
+	int32 NumChecks{ FMath::Min(Candidates.Num(), MaxLineOfSightChecks) };
+	for (int32 Index{ 0 }; Index < NumChecks; Index++)
+	{
+		AActor* Candidate{ Candidates[Index].Actor.Get() };
+		if (HasLineOfSight(Candidate))
+		{
+			return Candidate;
+		}
+	}
+
+	return nullptr;
+}
+
+bool ULockOnComponent::HasLineOfSight(const AActor* Target) const
+{
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	FCollisionQueryParams TraceParams{
+		FName{ TEXT("Lock On Line Of Sight") },
+		false,
+		OwnerRef
+	};
+	TraceParams.AddIgnoredActor(Target);
+
+	// Anything blocking visibility between the camera and the point it would aim at hides the enemy
+	return !GetWorld()->LineTraceTestByChannel(
+		ViewLocation,
+		ComputeAimLocation(Target),
+		ECollisionChannel::ECC_Visibility,
+		TraceParams
+	);
+}
+
 // Ends the lock-on and resets orientation settings
 void ULockOnComponent::EndLockOn()
 {
-	// Tell the enemy it's been deselected from lock-on (To disable UI)
-	IEnemy::Execute_OnDeselect(CurrentTargetActor);
+	// Tell the enemy it's been deselected from lock-on (To disable UI), unless it is already gone
+	if (IsValid(CurrentTargetActor))
+	{
+		IEnemy::Execute_OnDeselect(CurrentTargetActor);
+	}
 	
 	// Clear current target
 	CurrentTargetActor = nullptr;
+	TargetAimMesh = nullptr;
+	SetComponentTickEnabled(false);
+
+	bTargetOccluded = false;
+	if (VisibilitySubsystem)
+	{
+		VisibilitySubsystem->RemoveWatcher(this);
+	}
+
+	// Stop maintaining the switch list
+	GetWorld()->GetTimerManager().ClearTimer(SwitchCandidatesTimerHandle);
+	SwitchCandidates.Reset();
 	
 	// Restore movement orientation settings
 	MovementComp->bOrientRotationToMovement = true;
@@ -161,4 +324,252 @@ void ULockOnComponent::ToggleLockOn(float Radius)
 	}
 }
 
+// The component only ticks while locked on, so a lost target with tick still enabled was locked
+void ULockOnComponent::ReleaseLostTarget()
+{
+	if (IsComponentTickEnabled())
+	{
+		EndLockOn();
+	}
+}
+
+// Updates the candidate list in place, reusing the previous order to keep the sort cheap
+void ULockOnComponent::RefreshSwitchCandidates()
+{
+	if (!IsValid(CurrentTargetActor))
+	{
+		ReleaseLostTarget();
+		return;
+	}
+
+	if (!FighterRegistry) { return; }
+
+	TArray<AActor*> NearbyFighters;
+	FighterRegistry->GatherFighters(OwnerRef->GetActorLocation(), LockOnRadius, NearbyFighters, OwnerRef);
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Drop enemies that left range or the view, and update the angles of the rest
+	for (int32 Index{ SwitchCandidates.Num() - 1 }; Index >= 0; Index--)
+	{
+		FLockOnCandidate& Candidate{ SwitchCandidates[Index] };
+		int32 NearbyIndex{ NearbyFighters.Find(Candidate.Actor.Get()) };
 
+		if (NearbyIndex == INDEX_NONE || !EvaluateCandidate(Candidate, ViewLocation, ViewRotation, LockOnRadius))
+		{
+			SwitchCandidates.RemoveAt(Index);
+			continue;
+		}
+
+		NearbyFighters.RemoveAtSwap(NearbyIndex);
+	}
+
+	// Whatever is left came into range since the last refresh
+	for (AActor* Fighter : NearbyFighters)
+	{
+		if (!Fighter->Implements<UEnemy>()) { continue; }
+
+		FLockOnCandidate Candidate;
+		Candidate.Actor = Fighter;
+
+		if (EvaluateCandidate(Candidate, ViewLocation, ViewRotation, LockOnRadius))
+		{
+			SwitchCandidates.Add(Candidate);
+		}
+	}
+
+	// Angles barely change between refreshes, so an insertion sort is close to a single pass
+	for (int32 Index{ 1 }; Index < SwitchCandidates.Num(); Index++)
+	{
+		int32 SortedIndex{ Index };
+		while (SortedIndex > 0 &&
+			SwitchCandidates[SortedIndex - 1].ScreenYaw > SwitchCandidates[SortedIndex].ScreenYaw)
+		{
+			SwitchCandidates.Swap(SortedIndex - 1, SortedIndex);
+			SortedIndex--;
+		}
+	}
+}
+
+// Moves the lock-on to the nearest candidate on one side of the current target
+void ULockOnComponent::SwitchTarget(bool bRight)
+{
+	if (!IsValid(CurrentTargetActor))
+	{
+		ReleaseLostTarget();
+		return;
+	}
+
+	// The camera keeps the current target centered if it dropped out of the list
+	const FLockOnCandidate* CurrentCandidate{ SwitchCandidates.FindByPredicate(
+		[this](const FLockOnCandidate& Candidate) { return Candidate.Actor.Get() == CurrentTargetActor; }
+	) };
+	float CurrentYaw{ CurrentCandidate ? CurrentCandidate->ScreenYaw : 0.0f };
+
+	// The list is sorted left to right, so the first match walking outwards is the closest
+	AActor* NewTarget{ nullptr };
+	int32 Step{ bRight ? 1 : -1 };
+	int32 Index{ bRight ? 0 : SwitchCandidates.Num() - 1 };
+
+	for (; SwitchCandidates.IsValidIndex(Index); Index += Step)
+	{
+		const FLockOnCandidate& Candidate{ SwitchCandidates[Index] };
+		AActor* CandidateActor{ Candidate.Actor.Get() };
+		if (!IsValid(CandidateActor) || CandidateActor == CurrentTargetActor) { continue; }
+
+		bool bIsOnSide{ bRight ? Candidate.ScreenYaw > CurrentYaw : Candidate.ScreenYaw < CurrentYaw };
+		if (bIsOnSide)
+		{
+			NewTarget = CandidateActor;
+			break;
+		}
+	}
+
+	if (!NewTarget) { return; }
+
+	// Move the lock-on UI over to the new target
+	IEnemy::Execute_OnDeselect(CurrentTargetActor);
+	CurrentTargetActor = NewTarget;
+	CacheTargetAimPoint();
+	bTargetOccluded = false;
+	IEnemy::Execute_OnSelect(CurrentTargetActor);
+
+	// Broadcast event to notify other systems that the target was updated
+	OnUpdatedTargetDelegate.Broadcast(CurrentTargetActor);
+}
+
+// Finds the mesh and socket of the current target once instead of every frame
+void ULockOnComponent::CacheTargetAimPoint()
+{
+	TargetAimMesh = nullptr;
+	TargetAimSocket = NAME_None;
+
+	const IEnemy* Enemy{ Cast<IEnemy>(CurrentTargetActor) };
+	FName SocketName{ Enemy ? Enemy->GetLockOnAimSocket() : NAME_None };
+	if (SocketName.IsNone()) { return; }
+
+	USkeletalMeshComponent* TargetMesh{ CurrentTargetActor->FindComponentByClass<USkeletalMeshComponent>() };
+	if (!TargetMesh || !TargetMesh->DoesSocketExist(SocketName)) { return; }
+
+	TargetAimMesh = TargetMesh;
+	TargetAimSocket = SocketName;
+}
+
+FVector ULockOnComponent::GetTargetAimLocation() const
+{
+	if (const USkeletalMeshComponent* TargetMesh{ TargetAimMesh.Get() })
+	{
+		return TargetMesh->GetSocketLocation(TargetAimSocket);
+	}
+
+	return CurrentTargetActor->GetActorLocation() + FallbackAimOffset;
+}
+
+FVector ULockOnComponent::ComputeAimLocation(const AActor* Target) const
+{
+	const IEnemy* Enemy{ Cast<IEnemy>(Target) };
+	FName SocketName{ Enemy ? Enemy->GetLockOnAimSocket() : NAME_None };
+
+	if (!SocketName.IsNone())
+	{
+		const USkeletalMeshComponent* TargetMesh{ Target->FindComponentByClass<USkeletalMeshComponent>() };
+		if (TargetMesh && TargetMesh->DoesSocketExist(SocketName))
+		{
+			return TargetMesh->GetSocketLocation(SocketName);
+		}
+	}
+
+	return Target->GetActorLocation() + FallbackAimOffset;
+}
+
+bool ULockOnComponent::GetLineOfSightTrace(FVector& OutStart, FVector& OutEnd) const
+{
+	if (!IsValid(CurrentTargetActor)) { return false; }
+
+	FRotator ViewRotation;
+	Controller->GetPlayerViewPoint(OutStart, ViewRotation);
+	OutEnd = GetTargetAimLocation();
+	return true;
+}
+
+// Tracks how long the target has been hidden, the tick breaks the lock-on once it's too long
+void ULockOnComponent::HandleLineOfSightResult(const AActor* Target, bool bVisible)
+{
+	// Result for a target we switched away from
+	if (Target != CurrentTargetActor) { return; }
+
+	if (bVisible)
+	{
+		bTargetOccluded = false;
+		return;
+	}
+
+	if (!bTargetOccluded)
+	{
+		bTargetOccluded = true;
+		OccludedSinceTime = GetWorld()->GetTimeSeconds();
+	}
+}
+
+// Scores the cached nearby enemies against the owner's facing, repeated calls only refresh the cache when it's stale
+AActor* ULockOnComponent::FindSoftTarget(float Range, float ConeAngle)
+{
+	if (!FighterRegistry) { return nullptr; }
+
+	FVector CurrentLocation{ OwnerRef->GetActorLocation() };
+	double CurrentTime{ GetWorld()->GetTimeSeconds() };
+
+	if (CurrentTime - NearbyEnemiesTime >= SoftTargetCacheLifetime || Range > NearbyEnemiesRadius)
+	{
+		TArray<AActor*> NearbyFighters;
+		FighterRegistry->GatherFighters(CurrentLocation, Range, NearbyFighters, OwnerRef);
+
+		NearbyEnemies.Reset();
+		for (AActor* Fighter : NearbyFighters)
+		{
+			if (Fighter->Implements<UEnemy>())
+			{
+				NearbyEnemies.Add(Fighter);
+			}
+		}
+
+		NearbyEnemiesTime = CurrentTime;
+		NearbyEnemiesRadius = Range;
+	}
+
+	FVector Forward{ OwnerRef->GetActorForwardVector().GetSafeNormal2D() };
+	float SafeConeAngle{ FMath::Max(ConeAngle, KINDA_SMALL_NUMBER) };
+
+	AActor* BestTarget{ nullptr };
+	float BestScore{ -UE_BIG_NUMBER };
+
+	for (const TWeakObjectPtr<AActor>& EnemyRef : NearbyEnemies)
+	{
+		AActor* Enemy{ EnemyRef.Get() };
+		if (!IsValid(Enemy)) { continue; }
+
+		FVector ToEnemy{ Enemy->GetActorLocation() - CurrentLocation };
+		float Distance{ static_cast<float>(ToEnemy.Size2D()) };
+		if (Distance > Range) { continue; }
+
+		float Angle{ static_cast<float>(FMath::RadiansToDegrees(
+			FMath::Acos(FMath::Clamp(FVector::DotProduct(Forward, ToEnemy.GetSafeNormal2D()), -1.0, 1.0))
+		)) };
+		if (Angle > ConeAngle) { continue; }
+
+		float Score{
+			DistanceWeight * (1.0f - Distance / FMath::Max(Range, KINDA_SMALL_NUMBER)) +
+			AngleWeight * (1.0f - Angle / SafeConeAngle)
+		};
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestTarget = Enemy;
+		}
+	}
+
+	return BestTarget;
+}
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/LockOnVisibilitySubsystem.h"
+#include "Combat/LockOnComponent.h"
+
+/*
+ *	- Spreads lock-on line of sight traces over frames with a shared budget
+ *	- Issues them as async traces so results arrive without blocking the game thread
+ *	- Hands each result back to the lock-on component that asked for it
+ */
+
+void ULockOnVisibilitySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TraceDelegate.BindUObject(this, &ULockOnVisibilitySubsystem::OnTraceCompleted);
+}
+
+void ULockOnVisibilitySubsystem::AddWatcher(ULockOnComponent* Component)
+{
+	for (const FVisibilityWatcher& Watcher : Watchers)
+	{
+		if (Watcher.Component.Get() == Component) { return; }
+	}
+
+	FVisibilityWatcher Watcher;
+	Watcher.Component = Component;
+	Watchers.Add(Watcher);
+}
+
+void ULockOnVisibilitySubsystem::RemoveWatcher(ULockOnComponent* Component)
+{
+	for (auto It{ Watchers.CreateIterator() }; It; ++It)
+	{
+		if (It->Component.Get() == Component)
+		{
+			It.RemoveCurrent();
+			return;
+		}
+	}
+}
+
+void ULockOnVisibilitySubsystem::Tick(float DeltaTime)
+{
+	if (Watchers.Num() == 0)
+	{
+		TraceBudget = 0.0f;
+		return;
+	}
+
+	// Never bank more than one frame's worth so a hitch doesn't cause a burst of traces
+	TraceBudget = FMath::Min(TraceBudget + MaxTracesPerSecond * DeltaTime, FMath::Max(1.0f, MaxTracesPerSecond * DeltaTime));
+
+	double CurrentTime{ GetWorld()->GetTimeSeconds() };
+	int32 MaxIndex{ Watchers.GetMaxIndex() };
+
+	// One lap at most, starting where the last frame stopped
+	for (int32 Visited{ 0 }; Visited < MaxIndex && TraceBudget >= 1.0f; Visited++)
+	{
+		int32 WatcherIndex{ (NextWatcherIndex + Visited) % MaxIndex };
+		if (!Watchers.IsAllocated(WatcherIndex)) { continue; }
+
+		FVisibilityWatcher& Watcher{ Watchers[WatcherIndex] };
+		if (Watcher.bTracePending || CurrentTime - Watcher.LastCheckTime < MinCheckInterval) { continue; }
+
+		Watcher.LastCheckTime = CurrentTime;
+		IssueTrace(WatcherIndex);
+		TraceBudget -= 1.0f;
+		NextWatcherIndex = WatcherIndex + 1;
+	}
+}
+
+void ULockOnVisibilitySubsystem::IssueTrace(int32 WatcherIndex)
+{
+	FVisibilityWatcher& Watcher{ Watchers[WatcherIndex] };
+	ULockOnComponent* Component{ Watcher.Component.Get() };
+
+	FVector Start;
+	FVector End;
+	if (!Component || !Component->GetLineOfSightTrace(Start, End)) { return; }
+
+	Watcher.TracedTarget = Component->CurrentTargetActor;
+	Watcher.bTracePending = true;
+
+	FCollisionQueryParams TraceParams{
+		FName{ TEXT("Lock On Line Of Sight") },
+		false,
+		Component->GetOwner()
+	};
+	TraceParams.AddIgnoredActor(Component->CurrentTargetActor);
+
+	GetWorld()->AsyncLineTraceByChannel(
+		EAsyncTraceType::Single,
+		Start,
+		End,
+		ECollisionChannel::ECC_Visibility,
+		TraceParams,
+		FCollisionResponseParams::DefaultResponseParam,
+		&TraceDelegate,
+		static_cast<uint32>(WatcherIndex)
+	);
+}
+
+void ULockOnVisibilitySubsystem::OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	int32 WatcherIndex{ static_cast<int32>(TraceDatum.UserData) };
+	if (!Watchers.IsAllocated(WatcherIndex)) { return; }
+
+	FVisibilityWatcher& Watcher{ Watchers[WatcherIndex] };
+	Watcher.bTracePending = false;
+
+	// The component also drops results for a target it no longer holds
+	if (ULockOnComponent* Component{ Watcher.Component.Get() })
+	{
+		Component->HandleLineOfSightResult(Watcher.TracedTarget.Get(), TraceDatum.OutHits.Num() == 0);
+	}
+}
+
+TStatId ULockOnVisibilitySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULockOnVisibilitySubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/StatusEffectSubsystem.h"
+#include "Characters/StatsComponent.h"
+#include "Combat/CombatComponent.h"
+#include "GameFramework/Character.h"
+
+/*
+ *	- Stores active status effects as struct-of-arrays
+ *	- Ticks all of them in one pass on a fixed pulse
+ *	- Sums each target's damage over its effects, then applies it with one call to the stats component
+ *	- Interrupts the target's attack when it is staggered
+ */
+
+void UStatusEffectSubsystem::ApplyStatusEffect(AActor* Target, EStatusEffectType Type, float Duration,
+	float EffectDamagePerSecond)
+{
+	if (!IsValid(Target) || Duration <= 0.0f) { return; }
+
+	UStatsComponent* StatsComp{ Target->FindComponentByClass<UStatsComponent>() };
+	if (!StatsComp) { return; }
+
+	if (Type == EStatusEffectType::Stagger)
+	{
+		InterruptTarget(Target);
+	}
+
+	// Reapplying refreshes the effect instead of stacking it
+	int32 Index{ FindEffect(StatsComp, Type) };
+	if (Index != INDEX_NONE)
+	{
+		RemainingTime[Index] = FMath::Max(RemainingTime[Index], Duration);
+		DamagePerSecond[Index] = FMath::Max(DamagePerSecond[Index], EffectDamagePerSecond);
+		return;
+	}
+
+	Targets.Add(StatsComp);
+	Types.Add(Type);
+	DamagePerSecond.Add(EffectDamagePerSecond);
+	RemainingTime.Add(Duration);
+}
+
+void UStatusEffectSubsystem::InterruptTarget(AActor* Target)
+{
+	// The combat component also resets its attack state, the montage's reset notify won't fire anymore
+	if (UCombatComponent* CombatComp{ Target->FindComponentByClass<UCombatComponent>() })
+	{
+		CombatComp->InterruptAttack();
+		return;
+	}
+
+	if (ACharacter* Character{ Cast<ACharacter>(Target) })
+	{
+		Character->StopAnimMontage();
+	}
+}
+
+void UStatusEffectSubsystem::ClearStatusEffect(AActor* Target, EStatusEffectType Type)
+{
+	if (!IsValid(Target)) { return; }
+
+	int32 Index{ FindEffect(Target->FindComponentByClass<UStatsComponent>(), Type) };
+	if (Index != INDEX_NONE)
+	{
+		RemoveEffectAt(Index);
+	}
+}
+
+bool UStatusEffectSubsystem::HasStatusEffect(const AActor* Target, EStatusEffectType Type) const
+{
+	if (!IsValid(Target)) { return false; }
+
+	return FindEffect(Target->FindComponentByClass<UStatsComponent>(), Type) != INDEX_NONE;
+}
+
+int32 UStatusEffectSubsystem::FindEffect(const UStatsComponent* Target, EStatusEffectType Type) const
+{
+	if (!Target) { return INDEX_NONE; }
+
+	for (int32 Index{ 0 }; Index < Types.Num(); Index++)
+	{
+		if (Types[Index] == Type && Targets[Index].Get() == Target) { return Index; }
+	}
+
+	return INDEX_NONE;
+}
+
+void UStatusEffectSubsystem::RemoveEffectAt(int32 Index)
+{
+	Targets.RemoveAtSwap(Index);
+	Types.RemoveAtSwap(Index);
+	DamagePerSecond.RemoveAtSwap(Index);
+	RemainingTime.RemoveAtSwap(Index);
+}
+
+void UStatusEffectSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Types.Num() == 0)
+	{
+		TimeSinceLastPulse = 0.0f;
+		return;
+	}
+
+	TimeSinceLastPulse += DeltaTime;
+	if (TimeSinceLastPulse < PulseInterval) { return; }
+
+	const float PulseTime{ TimeSinceLastPulse };
+	TimeSinceLastPulse = 0.0f;
+
+	// Damaging effects next to each other by target, so each target's damage is summed in one run
+	PulseOrder.Reset();
+	for (int32 Index{ 0 }; Index < Types.Num(); Index++)
+	{
+		if (DamagePerSecond[Index] > 0.0f && Targets[Index].IsValid())
+		{
+			PulseOrder.Add(Index);
+		}
+	}
+
+	PulseOrder.Sort([this](int32 A, int32 B)
+	{
+		return Targets[A]->GetUniqueID() < Targets[B]->GetUniqueID();
+	});
+
+	PulseTargets.Reset();
+	PulseDamage.Reset();
+
+	for (int32 Index : PulseOrder)
+	{
+		// Only the part of the pulse the effect was still active for deals damage
+		const float ActiveTime{ FMath::Max(FMath::Min(PulseTime, RemainingTime[Index]), 0.0f) };
+		const float Damage{ DamagePerSecond[Index] * ActiveTime };
+
+		if (PulseTargets.Num() > 0 && PulseTargets.Last() == Targets[Index])
+		{
+			PulseDamage.Last() += Damage;
+			continue;
+		}
+
+		PulseTargets.Add(Targets[Index]);
+		PulseDamage.Add(Damage);
+	}
+
+	for (float& Time : RemainingTime)
+	{
+		Time -= PulseTime;
+	}
+
+	// Status damage isn't an attack, it can't be blocked, parried or rolled through
+	// Applied from the scratch arrays, so dying targets applying or clearing effects from their callbacks can't disturb it
+	for (int32 TargetIndex{ 0 }; TargetIndex < PulseTargets.Num(); TargetIndex++)
+	{
+		UStatsComponent* StatsComp{ PulseTargets[TargetIndex].Get() };
+		if (StatsComp && PulseDamage[TargetIndex] > 0.0f)
+		{
+			StatsComp->ReduceHealth(PulseDamage[TargetIndex], nullptr, true);
+		}
+	}
+
+	// Walk backwards so expired effects can be swapped out in place
+	for (int32 Index{ Types.Num() - 1 }; Index >= 0; Index--)
+	{
+		if (!Targets[Index].IsValid() || RemainingTime[Index] <= 0.0f)
+		{
+			RemoveEffectAt(Index);
+		}
+	}
+}
+
+TStatId UStatusEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusEffectSubsystem, STATGROUP_Tickables);
+}
@@ -1,25 +1,80 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Combat/TraceComponent.h"
-#include "Engine/DamageEvents.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Kismet/KismetMathLibrary.h"
 #include "Interfaces/Fighter.h"
-#include "Kismet/GameplayStatics.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Combat/HitEffectPoolSubsystem.h"
+#include "Combat/FighterRegistrySubsystem.h"
+#include "Combat/CombatHitBatchSubsystem.h"
+#include "Combat/TraceDebugSubsystem.h"
+#include "Combat/BodyZoneTable.h"
+#include "Combat/DamageResolver.h"
+#include "Components/CapsuleComponent.h"
+
+namespace
+{
+    // Finds the bone a socket is attached to, plain bone names resolve with an identity offset
+    FResolvedTraceSocket ResolveTraceSocket(const USkeletalMeshComponent* MeshComp, FName SocketName)
+    {
+        FResolvedTraceSocket Resolved;
+
+        if (const USkeletalMeshSocket* MeshSocket{ MeshComp->GetSocketByName(SocketName) })
+        {
+            Resolved.BoneIndex = MeshComp->GetBoneIndex(MeshSocket->BoneName);
+            Resolved.LocalOffset = MeshSocket->GetSocketLocalTransform();
+        }
+        else
+        {
+            Resolved.BoneIndex = MeshComp->GetBoneIndex(SocketName);
+        }
+
+        return Resolved;
+    }
+
+    // Fighters this close to the recording actor are captured as replay targets
+    constexpr double RecordedTargetRadius { 1000.0 };
+
+    // Where replay stand-ins wait on frames their target wasn't recorded on
+    const FVector ReplayParkedLocation { 0.0, 0.0, -UE_OLD_WORLD_MAX * 0.5 };
+}
 
 // Sets default values for this component's properties
 UTraceComponent::UTraceComponent()
 {
     PrimaryComponentTick.bCanEverTick = true;
+
+    // Ticking is switched on only for the duration of an attack window
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+
+    AsyncTraceDelegate.BindUObject(this, &UTraceComponent::OnAsyncTraceCompleted);
 }
 
 void UTraceComponent::BeginPlay()
 {
     Super::BeginPlay();
     SkeletalComp = GetOwner()->FindComponentByClass<USkeletalMeshComponent>();
+
+    // Sample sockets only after this frame's animation has been evaluated
+    if (SkeletalComp)
+    {
+        AddTickPrerequisiteComponent(SkeletalComp);
+    }
+
+    ResolveSockets();
+
+    FighterRegistry = GetWorld()->GetSubsystem<UFighterRegistrySubsystem>();
+
+    // Create this fighter's hit effects while the map loads rather than on the first hit
+    UHitEffectPoolSubsystem* EffectPool{ GetWorld()->GetSubsystem<UHitEffectPoolSubsystem>() };
+    if (EffectPool)
+    {
+        EffectPool->Prewarm(EHitEffectType::Normal, HitParticleTemplate, HitEffectPrewarmCount);
+        EffectPool->Prewarm(EHitEffectType::Block, BlockParticleTemplate, HitEffectPrewarmCount);
+        EffectPool->Prewarm(EHitEffectType::Parry, ParryParticleTemplate, HitEffectPrewarmCount);
+    }
 }
 
-void UTraceComponent::SpawnHitEffect(const FVector& Location, EHitEffectType HitType)
+void UTraceComponent::SpawnHitEffect(const FVector& Location, EHitEffectType HitType, EBodyZone Zone)
 {
     UParticleSystem* ParticleToSpawn = nullptr;
     
@@ -34,19 +89,19 @@ void UTraceComponent::SpawnHitEffect(const FVector& Location, EHitEffectType Hit
         case EHitEffectType::Normal:
         default:
             ParticleToSpawn = HitParticleTemplate;
+
+            if (UParticleSystem* const* ZoneParticle{ ZoneHitParticleTemplates.Find(Zone) })
+            {
+                ParticleToSpawn = *ZoneParticle;
+            }
             break;
     }
     
-    if (ParticleToSpawn)
-    {
-        UGameplayStatics::SpawnEmitterAtLocation(
-            GetWorld(),
-            ParticleToSpawn,
-            Location,
-            FRotator::ZeroRotator,  // Default rotation
-            FVector(1.0f),          // Default scale
-            true            // Auto destroy when complete
-        );
+    UHitEffectPoolSubsystem* EffectPool{ GetWorld()->GetSubsystem<UHitEffectPoolSubsystem>() };
+    
+    if (ParticleToSpawn && EffectPool)
+    {
+        EffectPool->SpawnEffect(HitType, ParticleToSpawn, Location);
     }
 }
 
@@ -56,62 +111,299 @@ void UTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActor
     
     if (!bIsAttacking) { return; }
     
+    ResolveSockets();
+
+    TArray<FTraceSocketPose> CurrentPoses;
+    GatherSocketPoses(CurrentPoses);
+
+    if (bIsRecording)
+    {
+        RecordFrame(CurrentPoses);
+    }
+
+    TracePoses(MoveTemp(CurrentPoses));
+}
+
+void UTraceComponent::RecordFrame(const TArray<FTraceSocketPose>& Poses)
+{
+    FTraceRecordingFrame& Frame { Recording.Frames.AddDefaulted_GetRef() };
+    Frame.Time = static_cast<float>(GetWorld()->GetTimeSeconds() - RecordingStartTime);
+    Frame.bWindowStart = PreviousPoses.Num() == 0;
+    Frame.Poses = Poses;
+
+    if (!FighterRegistry) { return; }
+
+    TArray<AActor*> NearbyFighters;
+    FighterRegistry->GatherFighters(GetOwner()->GetActorLocation(), RecordedTargetRadius, NearbyFighters, GetOwner());
+
+    for (AActor* Fighter : NearbyFighters)
+    {
+        int32* TargetIndex { RecordedTargetIndices.Find(Fighter) };
+        if (!TargetIndex)
+        {
+            FTraceRecordedTarget& Target { Recording.Targets.AddDefaulted_GetRef() };
+            Target.Name = Fighter->GetName();
+
+            // Non-character fighters are approximated from their root bounds
+            if (const UCapsuleComponent* Capsule { Cast<UCapsuleComponent>(Fighter->GetRootComponent()) })
+            {
+                Target.CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+                Target.CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+            }
+            else
+            {
+                FVector Extent { Fighter->GetRootComponent()->Bounds.BoxExtent };
+                Target.CapsuleRadius = static_cast<float>(FMath::Max(Extent.X, Extent.Y));
+                Target.CapsuleHalfHeight = static_cast<float>(Extent.Z);
+            }
+
+            TargetIndex = &RecordedTargetIndices.Add(Fighter, Recording.Targets.Num() - 1);
+        }
+
+        FTraceRecordedTargetPose& TargetPose { Frame.Targets.AddDefaulted_GetRef() };
+        TargetPose.TargetIndex = *TargetIndex;
+        TargetPose.Location = Fighter->GetActorLocation();
+        TargetPose.Rotation = Fighter->GetActorQuat();
+    }
+}
+
+void UTraceComponent::TracePoses(TArray<FTraceSocketPose>&& CurrentPoses)
+{
+    bool bCanSubStep { bUseSubSteps && PreviousPoses.Num() == CurrentPoses.Num() };
+
     TArray<FHitResult> AllResults;
     
-    for (const FTraceSockets Socket: Sockets)
+    for (int32 SocketIndex{ 0 }; SocketIndex < CurrentPoses.Num(); SocketIndex++)
     {
-        FVector StartSocketLocation { SkeletalComp->GetSocketLocation(Socket.Start) };
-        FVector EndSocketLocation { SkeletalComp->GetSocketLocation(Socket.End) };
-        FQuat ShapeRotation { SkeletalComp->GetSocketQuaternion(Socket.Rotation) };
-    
-        TArray<FHitResult> OutResults;
+        const FTraceSocketPose& CurrentPose { CurrentPoses[SocketIndex] };
 
-        double WeaponDistance { FVector::Distance(StartSocketLocation, EndSocketLocation) };
-        FVector BoxHalfExtent { BoxCollisionLength, BoxCollisionLength, WeaponDistance };
-        BoxHalfExtent /= 2;
-        FCollisionShape Box { FCollisionShape::MakeBox(BoxHalfExtent) };
+        if (!bCanSubStep)
+        {
+            SweepPose(CurrentPose, AllResults);
+            continue;
+        }
 
-        FCollisionQueryParams IgnoreParams {
-            FName { TEXT("Ignore Params") },
-            false,
-            GetOwner(),
-        };
+        // Sweep from just after the previous pose up to and including the current one,
+        // the previous pose itself was already swept last frame
+        const FTraceSocketPose& PreviousPose { PreviousPoses[SocketIndex] };
+        int32 SubSteps { GetSubStepCount(PreviousPose, CurrentPose) };
+        
+        for (int32 Step{ 1 }; Step <= SubSteps; Step++)
+        {
+            float Alpha { static_cast<float>(Step) / SubSteps };
+            SweepPose(FTraceSocketPose::Interpolate(PreviousPose, CurrentPose, Alpha), AllResults);
+        }
+    }
+
+    PreviousPoses = MoveTemp(CurrentPoses);
+
+    ProcessHits(AllResults);
+}
+
+void UTraceComponent::ResolveSockets()
+{
+    if (!SkeletalComp) { return; }
+
+    const USkinnedAsset* CurrentMesh { SkeletalComp->GetSkinnedAsset() };
+    if (ResolvedMesh.Get() == CurrentMesh && ResolvedSockets.Num() == Sockets.Num()) { return; }
+
+    ResolvedMesh = CurrentMesh;
+    ResolvedSockets.Reset(Sockets.Num());
+
+    for (const FTraceSockets& Socket: Sockets)
+    {
+        FResolvedTraceSockets& Resolved { ResolvedSockets.AddDefaulted_GetRef() };
+        Resolved.Start = ResolveTraceSocket(SkeletalComp, Socket.Start);
+        Resolved.End = ResolveTraceSocket(SkeletalComp, Socket.End);
+        Resolved.Rotation = ResolveTraceSocket(SkeletalComp, Socket.Rotation);
+    }
+}
+
+void UTraceComponent::GatherSocketPoses(TArray<FTraceSocketPose>& OutPoses) const
+{
+    OutPoses.Reset(Sockets.Num());
+
+    // One read of the component space pose serves every socket
+    const TArray<FTransform>& ComponentSpaceTransforms { SkeletalComp->GetComponentSpaceTransforms() };
+    const FTransform& ComponentToWorld { SkeletalComp->GetComponentTransform() };
+
+    // Follower meshes don't own their pose, let the engine map the bones for them
+    bool bOwnsPose { !SkeletalComp->LeaderPoseComponent.IsValid() };
+
+    auto ToWorld = [&](const FResolvedTraceSocket& Socket)
+    {
+        return Socket.LocalOffset * ComponentSpaceTransforms[Socket.BoneIndex] * ComponentToWorld;
+    };
     
-        bool bHasFoundTargets { GetWorld()->SweepMultiByChannel(
-            OutResults,
-            StartSocketLocation,
-            EndSocketLocation,
-            ShapeRotation,
-            ECollisionChannel::ECC_GameTraceChannel1,
-            Box,
-            IgnoreParams
-        ) };
+    for (int32 SocketIndex{ 0 }; SocketIndex < Sockets.Num(); SocketIndex++)
+    {
+        FTraceSocketPose& Pose { OutPoses.AddDefaulted_GetRef() };
+        const FResolvedTraceSockets& Resolved { ResolvedSockets[SocketIndex] };
 
-        for (FHitResult& Hit : OutResults) {
-            AllResults.Add(Hit);
+        bool bHasBones {
+            bOwnsPose &&
+            Resolved.IsValid() &&
+            ComponentSpaceTransforms.IsValidIndex(Resolved.Start.BoneIndex) &&
+            ComponentSpaceTransforms.IsValidIndex(Resolved.End.BoneIndex) &&
+            ComponentSpaceTransforms.IsValidIndex(Resolved.Rotation.BoneIndex)
+        };
+
+        if (bHasBones)
+        {
+            Pose.Start = ToWorld(Resolved.Start).GetLocation();
+            Pose.End = ToWorld(Resolved.End).GetLocation();
+            Pose.Rotation = ToWorld(Resolved.Rotation).GetRotation();
+            continue;
         }
 
-        if (bDebugMode)
+        // Unresolved names (e.g. sockets on attached components) fall back to the name lookup
+        const FTraceSockets& Socket { Sockets[SocketIndex] };
+        Pose.Start = SkeletalComp->GetSocketLocation(Socket.Start);
+        Pose.End = SkeletalComp->GetSocketLocation(Socket.End);
+        Pose.Rotation = SkeletalComp->GetSocketQuaternion(Socket.Rotation);
+    }
+}
+
+int32 UTraceComponent::GetSubStepCount(const FTraceSocketPose& From, const FTraceSocketPose& To) const
+{
+    if (MaxSubStepAngle <= 0.0f) { return MaxSubSteps; }
+
+    // Use the larger of the socket rotation and blade direction change so twisting and swinging both count
+    double RotationAngle { From.Rotation.AngularDistance(To.Rotation) };
+    double BladeAngle { FMath::Acos(FMath::Clamp(
+        FVector::DotProduct((From.End - From.Start).GetSafeNormal(), (To.End - To.Start).GetSafeNormal()),
+        -1.0, 1.0
+    )) };
+    double ArcDegrees { FMath::RadiansToDegrees(FMath::Max(RotationAngle, BladeAngle)) };
+    
+    int32 SubSteps { FMath::CeilToInt32(ArcDegrees / MaxSubStepAngle) };
+    return FMath::Clamp(SubSteps, 1, MaxSubSteps);
+}
+
+bool UTraceComponent::SweepPose(const FTraceSocketPose& Pose, TArray<FHitResult>& OutResults)
+{
+    double WeaponDistance { FVector::Distance(Pose.Start, Pose.End) };
+    FVector BoxHalfExtent { BoxCollisionLength, BoxCollisionLength, WeaponDistance };
+    BoxHalfExtent /= 2;
+    FCollisionShape Box { FCollisionShape::MakeBox(BoxHalfExtent) };
+
+    if (bUseFighterPrefilter && FighterRegistry)
+    {
+        // Conservative bounds of the rotated box swept from start to end
+        FBox SweptBounds { FBox(Pose.Start, Pose.Start).ExpandBy(BoxHalfExtent.Size()) };
+        SweptBounds += FBox(Pose.End, Pose.End).ExpandBy(BoxHalfExtent.Size());
+
+        if (!FighterRegistry->AnyFighterOverlaps(SweptBounds, GetOwner()))
         {
-            FVector CenterPoint{
-                UKismetMathLibrary::VLerp(
-                    StartSocketLocation, EndSocketLocation, 0.5f
-                )
-            };
-            
-            UKismetSystemLibrary::DrawDebugBox(
-                GetWorld(),
-                CenterPoint,
-                Box.GetExtent(),
-                bHasFoundTargets ? FLinearColor::Green : FLinearColor::Red,
-                ShapeRotation.Rotator(),
-                1.0f,
-                2.0f
-            );
+            if (ActiveReplayReport) { ActiveReplayReport->SkippedSweeps++; }
+
+            if (bDebugMode)
+            {
+                DrawDebugSweep(Pose.Start, Pose.End, Pose.Rotation, Box.GetExtent(), false);
+            }
+            return false;
         }
     }
 
-    if (AllResults.Num() == 0) { return; }
+    FCollisionQueryParams IgnoreParams {
+        FName { TEXT("Ignore Params") },
+        false,
+        GetOwner(),
+    };
+
+    if (ActiveReplayReport)
+    {
+        IgnoreParams.AddIgnoredActors(ReplayIgnoredActors);
+    }
+
+    if (bUseAsyncTrace)
+    {
+        GetWorld()->AsyncSweepByChannel(
+            EAsyncTraceType::Multi,
+            Pose.Start,
+            Pose.End,
+            Pose.Rotation,
+            ECollisionChannel::ECC_GameTraceChannel1,
+            Box,
+            IgnoreParams,
+            FCollisionResponseParams::DefaultResponseParam,
+            &AsyncTraceDelegate,
+            AttackWindowIndex
+        );
+
+        NumPendingAsyncTraces++;
+        return false;
+    }
+
+    if (ActiveReplayReport) { ActiveReplayReport->Sweeps++; }
+
+    TArray<FHitResult> PoseResults;
+
+    bool bHasFoundTargets { GetWorld()->SweepMultiByChannel(
+        PoseResults,
+        Pose.Start,
+        Pose.End,
+        Pose.Rotation,
+        ECollisionChannel::ECC_GameTraceChannel1,
+        Box,
+        IgnoreParams
+    ) };
+
+    OutResults.Append(PoseResults);
+
+    if (bDebugMode)
+    {
+        DrawDebugSweep(Pose.Start, Pose.End, Pose.Rotation, Box.GetExtent(), bHasFoundTargets);
+    }
+
+    return bHasFoundTargets;
+}
+
+void UTraceComponent::OnAsyncTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+    NumPendingAsyncTraces = FMath::Max(NumPendingAsyncTraces - 1, 0);
+
+    if (bDebugMode)
+    {
+        DrawDebugSweep(
+            TraceDatum.Start,
+            TraceDatum.End,
+            TraceDatum.Rot,
+            TraceDatum.CollisionParams.CollisionShape.GetExtent(),
+            TraceDatum.OutHits.Num() > 0
+        );
+    }
+
+    // A new window opened since this sweep was issued, its dedup list and attack id belong to the new swing
+    if (TraceDatum.UserData != AttackWindowIndex) { return; }
+
+    // Damage and hit effects are driven from here instead of the tick
+    ProcessHits(TraceDatum.OutHits);
+
+    // The attack ended while this sweep was in flight, finish the deferred reset now
+    if (bResetAfterPendingTraces && NumPendingAsyncTraces == 0)
+    {
+        bResetAfterPendingTraces = false;
+        TargetsToIgnore.Empty();
+    }
+}
+
+void UTraceComponent::DrawDebugSweep(const FVector& Start, const FVector& End, const FQuat& Rotation,
+    const FVector& HalfExtent, bool bHit) const
+{
+    // Boxes from every fighter are drawn together by the debug layer in one batch
+    if (UTraceDebugSubsystem* DebugLayer{ GetWorld()->GetSubsystem<UTraceDebugSubsystem>() })
+    {
+        DebugLayer->AddSweep(Start, End, Rotation, HalfExtent, bHit);
+    }
+}
+
+void UTraceComponent::ProcessHits(const TArray<FHitResult>& Hits)
+{
+    if (Hits.Num() == 0) { return; }
+
+    UCombatHitBatchSubsystem* HitBatch{ GetWorld()->GetSubsystem<UCombatHitBatchSubsystem>() };
+    if (!HitBatch && !ActiveReplayReport) { return; }
 
     float CharacterDamage{ 0.0f };
     IFighter* FighterRef{ Cast<IFighter>(GetOwner()) };
@@ -119,54 +411,253 @@ void UTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActor
         CharacterDamage = FighterRef->GetDamage();
     }
 
-    FDamageEvent TargetAttackedEvent;
-
-    for (const FHitResult& Hit : AllResults)
+    for (const FHitResult& Hit : Hits)
     {
         AActor* TargetActor{ Hit.GetActor() };
 
-        // Skip if we've already processed this actor
+        // Skip if we've already processed this actor (sub-steps often hit the same actor several times)
         if (TargetsToIgnore.Contains(TargetActor)) { continue; }
 
-        // Determine hit effect type based on target's state
-        EHitEffectType HitType = EHitEffectType::Normal;
-        IFighter* TargetFighter = Cast<IFighter>(TargetActor);
-        
-        if (TargetFighter)
+        TargetsToIgnore.AddUnique(TargetActor);
+
+        if (bDebugMode)
         {
-            if (TargetFighter->IsBlocking())
+            if (UTraceDebugSubsystem* DebugLayer{ GetWorld()->GetSubsystem<UTraceDebugSubsystem>() })
             {
-                if (TargetFighter->IsParrying())
-                {
-                    HitType = EHitEffectType::Parry;
-                }
-                else if (TargetFighter->IsBlockFailed())
-                {
-                    HitType = EHitEffectType::Normal;  // Use blood effect for failed block
-                }
-                else
-                {
-                    HitType = EHitEffectType::Block;
-                }
+                DebugLayer->AddHit(Hit.ImpactPoint);
             }
         }
 
-        // Only spawn effect once per hit actor
-        SpawnHitEffect(Hit.ImpactPoint, HitType);
+        // Replays only count hits, they must not hurt anyone in the world they run in
+        if (ActiveReplayReport)
+        {
+            if (ReplayTargets.Contains(TargetActor))
+            {
+                ActiveReplayReport->Hits++;
+            }
+            continue;
+        }
 
-        
-        TargetActor->TakeDamage(
-            CharacterDamage,
-            TargetAttackedEvent,
-            GetOwner()->GetInstigatorController(),
-            GetOwner()
-        );
-        
-        TargetsToIgnore.AddUnique(TargetActor);
+        // Block/parry state, damage and the hit effect are resolved at the end of the frame
+        FCombatHit CombatHit;
+        CombatHit.Attacker = GetOwner();
+        CombatHit.Target = TargetActor;
+        CombatHit.Source = this;
+        CombatHit.ImpactPoint = Hit.ImpactPoint;
+        CombatHit.Damage = CharacterDamage;
+        CombatHit.AttackId = CurrentAttackId;
+        CombatHit.HitDirection = (Hit.TraceEnd - Hit.TraceStart).GetSafeNormal();
+        CombatHit.StatusEffect = StatusEffectOnHit;
+
+        // Zone lookup is an array read on the target's precompiled table
+        IFighter* TargetFighter{ Cast<IFighter>(TargetActor) };
+        const UBodyZoneTable* ZoneTable{ TargetFighter ? TargetFighter->GetBodyZoneTable() : nullptr };
+        if (ZoneTable)
+        {
+            CombatHit.Zone = ZoneTable->ResolveHitZone(Hit);
+            CombatHit.ZoneMultiplier = ZoneTable->GetMultiplier(CombatHit.Zone);
+        }
+
+        HitBatch->QueueHit(MoveTemp(CombatHit));
     }
 }
 
 void UTraceComponent::HandleResetAttack()
 {
+    PreviousPoses.Reset();
+
+    // Sweeps from the last frames of the attack still count towards it, so keep the
+    // dedup list alive until they have been processed
+    if (NumPendingAsyncTraces > 0)
+    {
+        bResetAfterPendingTraces = true;
+        return;
+    }
+
     TargetsToIgnore.Empty();
-}
\ No newline at end of file
+}
+
+void UTraceComponent::SetAttackWindowActive(bool bActive)
+{
+    if (bIsAttacking == bActive) { return; }
+
+    bIsAttacking = bActive;
+    SetComponentTickEnabled(bActive);
+
+    if (bActive)
+    {
+        // New window must not interpolate from the last pose of the previous one
+        PreviousPoses.Reset();
+        CurrentAttackId = FDamageResolver::NewAttackId();
+
+        // Sweeps still in flight from the previous window are dropped on completion,
+        // so its deferred reset can happen right away
+        AttackWindowIndex++;
+        bResetAfterPendingTraces = false;
+        TargetsToIgnore.Empty();
+        return;
+    }
+
+    HandleResetAttack();
+}
+
+void UTraceComponent::StartTraceRecording()
+{
+    bIsRecording = true;
+    RecordingStartTime = GetWorld()->GetTimeSeconds();
+
+    Recording = FTraceRecording{};
+    Recording.OwnerName = GetOwner()->GetName();
+    RecordedTargetIndices.Reset();
+}
+
+bool UTraceComponent::StopTraceRecording(const FString& FilePath)
+{
+    if (!bIsRecording) { return false; }
+
+    bIsRecording = false;
+
+    bool bSaved { Recording.SaveToFile(FilePath) };
+    UE_LOG(LogTemp, Log, TEXT("Trace recording of %s: %d frames %s %s"),
+        *Recording.OwnerName, Recording.Frames.Num(), bSaved ? TEXT("saved to") : TEXT("failed to save to"), *FilePath);
+
+    Recording = FTraceRecording{};
+    RecordedTargetIndices.Reset();
+    return bSaved;
+}
+
+void UTraceComponent::ReplayRecording(const FTraceRecording& InRecording, FTraceReplayReport& OutReport)
+{
+    // Replays always sweep synchronously so each frame's cost can be measured
+    TGuardValue<bool> AsyncGuard { bUseAsyncTrace, false };
+    TGuardValue<FTraceReplayReport*> ReportGuard { ActiveReplayReport, &OutReport };
+
+    // Don't disturb an attack that is in progress in the live world
+    TArray<AActor*> LiveTargetsToIgnore { MoveTemp(TargetsToIgnore) };
+    TArray<FTraceSocketPose> LivePreviousPoses { MoveTemp(PreviousPoses) };
+    TargetsToIgnore.Reset();
+    PreviousPoses.Reset();
+
+    BeginReplayScene(InRecording);
+
+    for (const FTraceRecordingFrame& Frame : InRecording.Frames)
+    {
+        if (Frame.bWindowStart)
+        {
+            TargetsToIgnore.Reset();
+            PreviousPoses.Reset();
+            OutReport.Windows++;
+        }
+
+        PlaceReplayTargets(Frame);
+
+        TArray<FTraceSocketPose> FramePoses { Frame.Poses };
+
+        uint64 StartCycles { FPlatformTime::Cycles64() };
+        TracePoses(MoveTemp(FramePoses));
+        double FrameMs { FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) };
+
+        OutReport.Frames++;
+        OutReport.TotalMs += FrameMs;
+        OutReport.MaxFrameMs = FMath::Max(OutReport.MaxFrameMs, FrameMs);
+    }
+
+    EndReplayScene();
+
+    TargetsToIgnore = MoveTemp(LiveTargetsToIgnore);
+    PreviousPoses = MoveTemp(LivePreviousPoses);
+}
+
+void UTraceComponent::BeginReplayScene(const FTraceRecording& InRecording)
+{
+    UWorld* World { GetWorld() };
+
+    // Live fighters would make the prefilter and the hits depend on the world the replay runs in,
+    // the replay is synchronous so they can leave the registry for its duration
+    ReplayIgnoredActors.Reset();
+    if (FighterRegistry)
+    {
+        FighterRegistry->GatherFighters(FVector::ZeroVector, UE_OLD_WORLD_MAX, ReplayIgnoredActors);
+
+        for (AActor* Fighter : ReplayIgnoredActors)
+        {
+            FighterRegistry->UnregisterFighter(Fighter);
+        }
+    }
+
+    ReplayTargets.Reset(InRecording.Targets.Num());
+
+    for (const FTraceRecordedTarget& Target : InRecording.Targets)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+        SpawnParams.ObjectFlags |= RF_Transient;
+
+        // Kept even when null so the indices keep matching the recorded targets
+        AActor* StandIn { World->SpawnActor<AActor>(AActor::StaticClass(), FTransform { ReplayParkedLocation }, SpawnParams) };
+        ReplayTargets.Add(StandIn);
+        if (!StandIn) { continue; }
+
+        UCapsuleComponent* Capsule { NewObject<UCapsuleComponent>(StandIn) };
+        Capsule->InitCapsuleSize(Target.CapsuleRadius, Target.CapsuleHalfHeight);
+        Capsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+        Capsule->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+        Capsule->SetCollisionResponseToChannel(ECollisionChannel::ECC_GameTraceChannel1, ECollisionResponse::ECR_Overlap);
+        StandIn->SetRootComponent(Capsule);
+        Capsule->SetWorldLocation(ReplayParkedLocation);
+        Capsule->RegisterComponent();
+
+        if (FighterRegistry)
+        {
+            FighterRegistry->RegisterFighter(StandIn);
+        }
+    }
+}
+
+void UTraceComponent::PlaceReplayTargets(const FTraceRecordingFrame& Frame)
+{
+    for (int32 TargetIndex{ 0 }; TargetIndex < ReplayTargets.Num(); TargetIndex++)
+    {
+        if (!ReplayTargets[TargetIndex]) { continue; }
+
+        const FTraceRecordedTargetPose* TargetPose { Frame.Targets.FindByPredicate(
+            [TargetIndex](const FTraceRecordedTargetPose& Pose) { return Pose.TargetIndex == TargetIndex; }
+        ) };
+
+        // Teleporting also moves the stand-in between the registry's cells
+        ReplayTargets[TargetIndex]->SetActorLocationAndRotation(
+            TargetPose ? TargetPose->Location : ReplayParkedLocation,
+            TargetPose ? TargetPose->Rotation : FQuat::Identity,
+            false,
+            nullptr,
+            ETeleportType::TeleportPhysics
+        );
+    }
+}
+
+void UTraceComponent::EndReplayScene()
+{
+    for (AActor* StandIn : ReplayTargets)
+    {
+        if (!StandIn) { continue; }
+
+        if (FighterRegistry)
+        {
+            FighterRegistry->UnregisterFighter(StandIn);
+        }
+
+        StandIn->Destroy();
+    }
+
+    ReplayTargets.Reset();
+
+    if (FighterRegistry)
+    {
+        for (AActor* Fighter : ReplayIgnoredActors)
+        {
+            FighterRegistry->RegisterFighter(Fighter);
+        }
+    }
+
+    ReplayIgnoredActors.Reset();
+}
@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/TraceDebugSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+/*
+ *	- Ring buffers of recent weapon sweeps and hits
+ *	- One batched line push per frame, independent of how many fighters are tracing
+ *	- Freeze / scrub through the buffered history
+ */
+
+namespace
+{
+	// Lines live for a single frame, the layer redraws whatever is in view every tick
+	constexpr float SingleFrameLifeTime{ KINDA_SMALL_NUMBER };
+	constexpr float LineThickness{ 2.0f };
+	constexpr float HitMarkerSize{ 8.0f };
+
+	FAutoConsoleCommandWithWorld FreezeCommand(
+		TEXT("ActionCombat.TraceDebug.Freeze"),
+		TEXT("Toggles freezing the weapon trace debug view"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (UTraceDebugSubsystem* DebugLayer{ World->GetSubsystem<UTraceDebugSubsystem>() })
+			{
+				DebugLayer->SetFrozen(!DebugLayer->IsFrozen());
+			}
+		})
+	);
+
+	FAutoConsoleCommandWithWorldAndArgs ScrubCommand(
+		TEXT("ActionCombat.TraceDebug.Scrub"),
+		TEXT("ActionCombat.TraceDebug.Scrub <Seconds> - shows the frozen trace history this many seconds back"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UTraceDebugSubsystem* DebugLayer{ World->GetSubsystem<UTraceDebugSubsystem>() };
+			if (!DebugLayer || Args.Num() == 0) { return; }
+
+			if (!DebugLayer->IsFrozen())
+			{
+				DebugLayer->SetFrozen(true);
+			}
+			DebugLayer->SetScrub(FCString::Atod(*Args[0]));
+		})
+	);
+
+	FAutoConsoleCommandWithWorldAndArgs WindowCommand(
+		TEXT("ActionCombat.TraceDebug.Window"),
+		TEXT("ActionCombat.TraceDebug.Window <Seconds> - how many seconds of trace history are drawn"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UTraceDebugSubsystem* DebugLayer{ World->GetSubsystem<UTraceDebugSubsystem>() };
+			if (!DebugLayer || Args.Num() == 0) { return; }
+
+			DebugLayer->SetDisplaySeconds(FCString::Atof(*Args[0]));
+		})
+	);
+}
+
+void UTraceDebugSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Buffers are sized once, their entries are only ever overwritten
+	Sweeps.Reserve(MaxSweeps);
+	Hits.Reserve(MaxHits);
+}
+
+void UTraceDebugSubsystem::AddSweep(const FVector& Start, const FVector& End, const FQuat& Rotation,
+	const FVector& HalfExtent, bool bHit)
+{
+	// Live sweeps would overwrite the history being scrubbed
+	if (bFrozen) { return; }
+
+	FSweepShape Shape;
+	Shape.Time = GetWorld()->GetTimeSeconds();
+	Shape.Center = FMath::Lerp(Start, End, 0.5);
+	Shape.HalfExtent = HalfExtent;
+	Shape.Rotation = Rotation;
+	Shape.bHit = bHit;
+
+	if (Sweeps.Num() < MaxSweeps)
+	{
+		Sweeps.Add(Shape);
+	}
+	else
+	{
+		Sweeps[NextSweep] = Shape;
+	}
+	NextSweep = (NextSweep + 1) % MaxSweeps;
+}
+
+void UTraceDebugSubsystem::AddHit(const FVector& Location)
+{
+	if (bFrozen) { return; }
+
+	FHitMarker Hit{ GetWorld()->GetTimeSeconds(), Location };
+
+	if (Hits.Num() < MaxHits)
+	{
+		Hits.Add(Hit);
+	}
+	else
+	{
+		Hits[NextHit] = Hit;
+	}
+	NextHit = (NextHit + 1) % MaxHits;
+}
+
+void UTraceDebugSubsystem::SetFrozen(bool bInFrozen)
+{
+	bFrozen = bInFrozen;
+	FrozenTime = GetWorld()->GetTimeSeconds();
+	ScrubSeconds = 0.0;
+}
+
+void UTraceDebugSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Sweeps.Num() == 0 && Hits.Num() == 0) { return; }
+
+	double LatestTime{ bFrozen ? FrozenTime : GetWorld()->GetTimeSeconds() };
+	double ViewTime{ LatestTime - ScrubSeconds };
+	double OldestTime{ FMath::Max(ViewTime - DisplaySeconds, LatestTime - HistorySeconds) };
+
+	Lines.Reset();
+
+	for (const FSweepShape& Shape : Sweeps)
+	{
+		if (Shape.Time < OldestTime || Shape.Time > ViewTime) { continue; }
+
+		AddBoxLines(Shape, Shape.bHit ? FLinearColor::Green : FLinearColor::Red);
+	}
+
+	for (const FHitMarker& Hit : Hits)
+	{
+		if (Hit.Time < OldestTime || Hit.Time > ViewTime) { continue; }
+
+		AddHitLines(Hit, FLinearColor::Yellow);
+	}
+
+	if (Lines.Num() == 0) { return; }
+
+	if (ULineBatchComponent* LineBatcher{ GetWorld()->GetLineBatcher(UWorld::ELineBatcherType::World) })
+	{
+		LineBatcher->DrawLines(Lines);
+	}
+}
+
+TStatId UTraceDebugSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTraceDebugSubsystem, STATGROUP_Tickables);
+}
+
+void UTraceDebugSubsystem::AddBoxLines(const FSweepShape& Shape, const FLinearColor& Color)
+{
+	FTransform BoxTransform{ Shape.Rotation, Shape.Center };
+
+	FVector Corners[8];
+	for (int32 CornerIndex{ 0 }; CornerIndex < 8; CornerIndex++)
+	{
+		FVector Local{
+			(CornerIndex & 1) ? Shape.HalfExtent.X : -Shape.HalfExtent.X,
+			(CornerIndex & 2) ? Shape.HalfExtent.Y : -Shape.HalfExtent.Y,
+			(CornerIndex & 4) ? Shape.HalfExtent.Z : -Shape.HalfExtent.Z
+		};
+		Corners[CornerIndex] = BoxTransform.TransformPosition(Local);
+	}
+
+	// Each edge joins two corners that differ in exactly one axis bit
+	for (int32 CornerIndex{ 0 }; CornerIndex < 8; CornerIndex++)
+	{
+		for (int32 AxisBit{ 1 }; AxisBit < 8; AxisBit <<= 1)
+		{
+			int32 OtherCorner{ CornerIndex | AxisBit };
+			if (OtherCorner == CornerIndex) { continue; }
+
+			Lines.Emplace(Corners[CornerIndex], Corners[OtherCorner], Color, SingleFrameLifeTime, LineThickness, SDPG_World);
+		}
+	}
+}
+
+void UTraceDebugSubsystem::AddHitLines(const FHitMarker& Hit, const FLinearColor& Color)
+{
+	const FVector Axes[3]{ FVector::XAxisVector, FVector::YAxisVector, FVector::ZAxisVector };
+
+	for (const FVector& Axis : Axes)
+	{
+		Lines.Emplace(
+			Hit.Location - Axis * HitMarkerSize,
+			Hit.Location + Axis * HitMarkerSize,
+			Color, SingleFrameLifeTime, LineThickness, SDPG_World
+		);
+	}
+}
@@ -0,0 +1,272 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Combat/TraceRecording.h"
+#include "Combat/TraceComponent.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/*
+ *	- Binary format for recorded trace socket poses and the targets around them
+ *	- Console commands to record live attacks and replay them headless:
+ *	  ActionCombat.Trace.StartRecording / StopRecording
+ *	  ActionCombat.Trace.Replay <File> [Iterations]
+ *	  (e.g. -nullrhi -ExecCmds="ActionCombat.Trace.Replay BP_Boss_C_0" on a CI box)
+ *	- ActionCombat.Combat.TraceReplay automation test covers the replay without any recorded files
+ */
+
+namespace
+{
+	constexpr uint32 TraceRecordingMagic{ 0x52544341 }; // "ACTR"
+	constexpr uint32 TraceRecordingVersion{ 2 };
+
+	// Fewest bytes one element of each list takes in the file, bounds the counts read back
+	constexpr int64 MinTargetSize{ sizeof(int32) + 2 * sizeof(float) };
+	constexpr int64 MinFrameSize{ sizeof(float) + sizeof(uint8) + 2 * sizeof(int32) };
+	constexpr int64 MinPoseSize{ sizeof(FVector3f) * 2 + sizeof(FQuat4f) };
+	constexpr int64 MinTargetPoseSize{ sizeof(int32) + sizeof(FVector3f) + sizeof(FQuat4f) };
+
+	// Counts of a truncated or corrupt file would fail SetNum or run out of memory, so they are
+	// rejected if negative or more than the rest of the file could hold
+	bool SerializeCount(FArchive& Ar, int32& Count, int64 MinElementSize)
+	{
+		Ar << Count;
+
+		if (!Ar.IsLoading()) { return true; }
+
+		if (Ar.IsError() || Count < 0 || Count > (Ar.TotalSize() - Ar.Tell()) / MinElementSize)
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		return true;
+	}
+
+	// Poses are stored in single precision, plenty for weapon sockets near the origin
+	void SerializePose(FArchive& Ar, FTraceSocketPose& Pose)
+	{
+		FVector3f Start{ Pose.Start };
+		FVector3f End{ Pose.End };
+		FQuat4f Rotation{ Pose.Rotation };
+
+		Ar << Start << End << Rotation;
+
+		if (Ar.IsLoading())
+		{
+			Pose.Start = FVector{ Start };
+			Pose.End = FVector{ End };
+			Pose.Rotation = FQuat{ Rotation };
+		}
+	}
+
+	void SerializeTargetPose(FArchive& Ar, FTraceRecordedTargetPose& Pose)
+	{
+		FVector3f Location{ Pose.Location };
+		FQuat4f Rotation{ Pose.Rotation };
+
+		Ar << Pose.TargetIndex << Location << Rotation;
+
+		if (Ar.IsLoading())
+		{
+			Pose.Location = FVector{ Location };
+			Pose.Rotation = FQuat{ Rotation };
+		}
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FTraceRecording& Recording)
+{
+	uint32 Magic{ TraceRecordingMagic };
+	uint32 Version{ TraceRecordingVersion };
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != TraceRecordingMagic || Version != TraceRecordingVersion))
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Recording.OwnerName;
+
+	int32 NumTargets{ Recording.Targets.Num() };
+	if (!SerializeCount(Ar, NumTargets, MinTargetSize)) { return Ar; }
+
+	if (Ar.IsLoading())
+	{
+		Recording.Targets.SetNum(NumTargets);
+	}
+
+	for (FTraceRecordedTarget& Target : Recording.Targets)
+	{
+		Ar << Target.Name << Target.CapsuleRadius << Target.CapsuleHalfHeight;
+	}
+
+	int32 NumFrames{ Recording.Frames.Num() };
+	if (!SerializeCount(Ar, NumFrames, MinFrameSize)) { return Ar; }
+
+	if (Ar.IsLoading())
+	{
+		Recording.Frames.SetNum(NumFrames);
+	}
+
+	for (FTraceRecordingFrame& Frame : Recording.Frames)
+	{
+		uint8 bWindowStart{ Frame.bWindowStart };
+		int32 NumPoses{ Frame.Poses.Num() };
+		Ar << Frame.Time << bWindowStart;
+		if (!SerializeCount(Ar, NumPoses, MinPoseSize)) { return Ar; }
+
+		if (Ar.IsLoading())
+		{
+			Frame.bWindowStart = bWindowStart != 0;
+			Frame.Poses.SetNum(NumPoses);
+		}
+
+		for (FTraceSocketPose& Pose : Frame.Poses)
+		{
+			SerializePose(Ar, Pose);
+		}
+
+		int32 NumTargetPoses{ Frame.Targets.Num() };
+		if (!SerializeCount(Ar, NumTargetPoses, MinTargetPoseSize)) { return Ar; }
+
+		if (Ar.IsLoading())
+		{
+			Frame.Targets.SetNum(NumTargetPoses);
+		}
+
+		for (FTraceRecordedTargetPose& TargetPose : Frame.Targets)
+		{
+			SerializeTargetPose(Ar, TargetPose);
+
+			if (Ar.IsLoading() && !Recording.Targets.IsValidIndex(TargetPose.TargetIndex))
+			{
+				Ar.SetError();
+				return Ar;
+			}
+		}
+	}
+
+	return Ar;
+}
+
+bool FTraceRecording::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer{ Bytes };
+	Writer << const_cast<FTraceRecording&>(*this);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FTraceRecording::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath)) { return false; }
+
+	return LoadFromBytes(Bytes);
+}
+
+bool FTraceRecording::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+	FMemoryReader Reader{ Bytes };
+	Reader << *this;
+
+	return !Reader.IsError();
+}
+
+FString FTraceRecording::GetDefaultFilePath(const FString& RecordingName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("TraceRecordings") / RecordingName + TEXT(".trace");
+}
+
+UTraceComponent* FTraceRecording::FindRecordedTraceComponent(UWorld* World) const
+{
+	for (TActorIterator<AActor> It{ World }; It; ++It)
+	{
+		if (It->GetName() == OwnerName)
+		{
+			return It->FindComponentByClass<UTraceComponent>();
+		}
+	}
+
+	return nullptr;
+}
+
+namespace
+{
+	FAutoConsoleCommandWithWorld StartRecordingCommand(
+		TEXT("ActionCombat.Trace.StartRecording"),
+		TEXT("Starts recording the weapon trace poses of every fighter in the world"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			for (TActorIterator<AActor> It{ World }; It; ++It)
+			{
+				if (UTraceComponent* TraceComp{ It->FindComponentByClass<UTraceComponent>() })
+				{
+					TraceComp->StartTraceRecording();
+				}
+			}
+		})
+	);
+
+	FAutoConsoleCommandWithWorld StopRecordingCommand(
+		TEXT("ActionCombat.Trace.StopRecording"),
+		TEXT("Stops recording and saves one file per fighter to Saved/TraceRecordings"),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			for (TActorIterator<AActor> It{ World }; It; ++It)
+			{
+				if (UTraceComponent* TraceComp{ It->FindComponentByClass<UTraceComponent>() })
+				{
+					TraceComp->StopTraceRecording(FTraceRecording::GetDefaultFilePath(It->GetName()));
+				}
+			}
+		})
+	);
+
+	FAutoConsoleCommandWithWorldAndArgs ReplayCommand(
+		TEXT("ActionCombat.Trace.Replay"),
+		TEXT("ActionCombat.Trace.Replay <File or recording name> [Iterations] - replays a recording through the trace of the actor it was recorded from and logs hits, query counts and per-frame cost"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (Args.Num() == 0) { return; }
+
+			FString FilePath{ FPaths::FileExists(Args[0]) ? Args[0] : FTraceRecording::GetDefaultFilePath(Args[0]) };
+			int32 Iterations{ Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1 };
+
+			FTraceRecording Recording;
+			if (!Recording.LoadFromFile(FilePath))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Trace replay: could not load %s"), *FilePath);
+				return;
+			}
+
+			// Another actor's sweep settings would give different numbers, so don't substitute one
+			UTraceComponent* TraceComp{ Recording.FindRecordedTraceComponent(World) };
+			if (!TraceComp)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Trace replay: %s, the actor %s was recorded from, has no trace component in this world"),
+					*FilePath, *Recording.OwnerName);
+				return;
+			}
+
+			for (int32 Iteration{ 0 }; Iteration < Iterations; Iteration++)
+			{
+				FTraceReplayReport Report;
+				TraceComp->ReplayRecording(Recording, Report);
+
+				UE_LOG(LogTemp, Display,
+					TEXT("Trace replay %s [%d/%d]: %d frames, %d windows, %d hits, %d sweeps, %d skipped, %.3f ms total, %.4f ms avg, %.4f ms max"),
+					*Recording.OwnerName, Iteration + 1, Iterations,
+					Report.Frames, Report.Windows, Report.Hits, Report.Sweeps, Report.SkippedSweeps,
+					Report.TotalMs, Report.GetAverageFrameMs(), Report.MaxFrameMs);
+			}
+		})
+	);
+}
@@ -2,5 +2,16 @@
 
 
 #include "Interfaces/Fighter.h"
+#include "Combat/CombatDamageEvent.h"
 
 // Add default functionality here for any IFighter functions that are not pure virtual.
+
+void IFighter::ResolveIncomingDamage(const FCombatDamageEvent& DamageEvent, AActor* Attacker,
+	FDamageResolution& OutResolution)
+{
+	if (!CanTakeDamage(Attacker))
+	{
+		OutResolution.Result = EDamageResult::Evaded;
+		OutResolution.FinalDamage = 0.0f;
+	}
+}
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+ *	Empty game world with its subsystems and physics scene, alive for the scope of one automation test.
+ *	Needs no map or rendering, so the tests also run headless (-nullrhi)
+ */
+
+struct FCombatTestWorld
+{
+	UWorld* World{ nullptr };
+
+	FCombatTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false);
+
+		FWorldContext& WorldContext{ GEngine->CreateNewWorldContext(EWorldType::Game) };
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL{});
+		World->BeginPlay();
+
+		// Without a game mode nothing starts play, actors spawned from here on need their BeginPlay
+		if (!World->HasBegunPlay())
+		{
+			World->GetWorldSettings()->NotifyBeginPlay();
+		}
+	}
+
+	~FCombatTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	FCombatTestWorld(const FCombatTestWorld&) = delete;
+	FCombatTestWorld& operator=(const FCombatTestWorld&) = delete;
+};
+
+#endif
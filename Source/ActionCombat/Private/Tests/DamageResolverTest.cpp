@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Tests/CombatTestWorld.h"
+#include "Combat/DamageResolver.h"
+#include "Combat/BlockComponent.h"
+#include "Characters/MainCharacter.h"
+#include "Characters/StatsComponent.h"
+#include "Characters/PlayerActionsComponent.h"
+
+/*
+ *	- Resolves typed hits against the main character through FDamageResolver
+ *	- Checks the applied, i-frame, parry and block outcomes and the health each one leaves
+ *	- Run headless with: -nullrhi -ExecCmds="Automation RunTests ActionCombat.Combat.DamageResolver; Quit"
+ */
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FDamageResolverTest,
+	"ActionCombat.Combat.DamageResolver",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FDamageResolverTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	UWorld* World{ TestWorld.World };
+
+	// Player at the origin facing +X
+	AMainCharacter* Player{ World->SpawnActor<AMainCharacter>(FVector::ZeroVector, FRotator::ZeroRotator) };
+	if (!TestNotNull(TEXT("Player spawned"), Player)) { return false; }
+
+	Player->StatsComp->SetStat(EStat::MaxHealth, 100.0f);
+	Player->StatsComp->SetStat(EStat::Health, 100.0f);
+	Player->StatsComp->SetStat(EStat::MaxStamina, 100.0f);
+	Player->StatsComp->SetStat(EStat::Stamina, 100.0f);
+
+	// Attacker in front of the player, facing it so a block is well angled
+	AActor* Attacker{ World->SpawnActor<AActor>() };
+	USceneComponent* AttackerRoot{ NewObject<USceneComponent>(Attacker) };
+	Attacker->SetRootComponent(AttackerRoot);
+	AttackerRoot->RegisterComponent();
+	Attacker->SetActorLocationAndRotation(FVector{ 200.0, 0.0, 0.0 }, FRotator{ 0.0, 180.0, 0.0 });
+
+	FCombatDamageEvent DamageEvent;
+	DamageEvent.AttackId = FDamageResolver::NewAttackId();
+	DamageEvent.Damage = 10.0f;
+	DamageEvent.HitDirection = FVector{ -1.0, 0.0, 0.0 };
+
+	// Undefended hit takes the full damage
+	FDamageResolution Resolution{ FDamageResolver::ApplyDamage(Player, Attacker, DamageEvent) };
+	TestTrue(TEXT("Undefended hit is applied"), Resolution.Result == EDamageResult::Applied);
+	TestEqual(TEXT("Applied damage"), Resolution.FinalDamage, 10.0f);
+	TestEqual(TEXT("Health after applied hit"), Player->StatsComp->GetStat(EStat::Health), 90.0f);
+	TestEqual(TEXT("Resolution keeps the attack id"), Resolution.AttackId, DamageEvent.AttackId);
+
+	// Rolling is invulnerable
+	Player->PlayerActionsComp->bIsRollActive = true;
+
+	Resolution = FDamageResolver::ApplyDamage(Player, Attacker, DamageEvent);
+	TestTrue(TEXT("Hit during a roll is evaded"), Resolution.Result == EDamageResult::Evaded);
+	TestEqual(TEXT("Evaded damage"), Resolution.FinalDamage, 0.0f);
+	TestEqual(TEXT("Health after evaded hit"), Player->StatsComp->GetStat(EStat::Health), 90.0f);
+
+	Player->PlayerActionsComp->bIsRollActive = false;
+
+	// First hit right after raising the block lands in the parry window
+	Player->BlockComp->StartBlocking();
+
+	Resolution = FDamageResolver::ApplyDamage(Player, Attacker, DamageEvent);
+	TestTrue(TEXT("Hit at the start of a block is parried"), Resolution.Result == EDamageResult::Parried);
+	TestEqual(TEXT("Parried damage"), Resolution.FinalDamage, 0.0f);
+
+	// The parry was used up, the next hit is blocked and reduced
+	Resolution = FDamageResolver::ApplyDamage(Player, Attacker, DamageEvent);
+	TestTrue(TEXT("Hit on a held block is blocked"), Resolution.Result == EDamageResult::Blocked);
+	TestTrue(TEXT("Blocked damage is reduced"), Resolution.FinalDamage > 0.0f && Resolution.FinalDamage < 10.0f);
+	TestEqual(TEXT("Health after blocked hit"),
+		Player->StatsComp->GetStat(EStat::Health), 90.0f - Resolution.FinalDamage);
+
+	// Hit from behind gets past the block
+	Attacker->SetActorLocationAndRotation(FVector{ -200.0, 0.0, 0.0 }, FRotator::ZeroRotator);
+
+	Resolution = FDamageResolver::ApplyDamage(Player, Attacker, DamageEvent);
+	TestTrue(TEXT("Hit from behind is applied"), Resolution.Result == EDamageResult::Applied);
+	TestEqual(TEXT("Damage from behind"), Resolution.FinalDamage, 10.0f);
+
+	Player->BlockComp->StopBlocking();
+
+	return true;
+}
+
+#endif
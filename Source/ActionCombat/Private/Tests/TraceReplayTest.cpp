@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Tests/CombatTestWorld.h"
+#include "Combat/TraceComponent.h"
+#include "Combat/TraceRecording.h"
+#include "Combat/FighterRegistrySubsystem.h"
+#include "Components/CapsuleComponent.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/*
+ *	- Replays a hand-built recording through a trace component in an empty world
+ *	- Checks hits, sweeps and prefilter skips, and that live fighters don't leak into the numbers
+ *	- Run headless with: -nullrhi -ExecCmds="Automation RunTests ActionCombat.Combat.TraceReplay; Quit"
+ */
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Blade crossing the Y axis at X = 200, moved along Y by Offset
+	FTraceSocketPose MakeBladePose(double Offset)
+	{
+		FTraceSocketPose Pose;
+		Pose.Start = FVector{ 200.0, Offset - 100.0, 0.0 };
+		Pose.End = FVector{ 200.0, Offset + 100.0, 0.0 };
+		Pose.Rotation = FQuat::Identity;
+		return Pose;
+	}
+
+	FTraceRecordingFrame MakeFrame(bool bWindowStart, double BladeOffset, bool bTargetPresent)
+	{
+		FTraceRecordingFrame Frame;
+		Frame.bWindowStart = bWindowStart;
+		Frame.Poses.Add(MakeBladePose(BladeOffset));
+
+		if (bTargetPresent)
+		{
+			FTraceRecordedTargetPose& TargetPose{ Frame.Targets.AddDefaulted_GetRef() };
+			TargetPose.TargetIndex = 0;
+			TargetPose.Location = FVector{ 200.0, 0.0, 0.0 };
+		}
+
+		return Frame;
+	}
+
+	AActor* SpawnActorWithRoot(UWorld* World, USceneComponent*& OutRoot, bool bCapsule)
+	{
+		AActor* Actor{ World->SpawnActor<AActor>() };
+
+		OutRoot = bCapsule ? NewObject<UCapsuleComponent>(Actor) : NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(OutRoot);
+		OutRoot->RegisterComponent();
+
+		return Actor;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FTraceReplayTest,
+	"ActionCombat.Combat.TraceReplay",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FTraceReplayTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	UWorld* World{ TestWorld.World };
+
+	USceneComponent* AttackerRoot{ nullptr };
+	AActor* Attacker{ SpawnActorWithRoot(World, AttackerRoot, false) };
+
+	UTraceComponent* TraceComp{ NewObject<UTraceComponent>(Attacker) };
+	TraceComp->RegisterComponent();
+
+	// Live fighter standing exactly where the recorded target stood, the replay must not see it
+	USceneComponent* LiveRoot{ nullptr };
+	AActor* LiveFighter{ SpawnActorWithRoot(World, LiveRoot, true) };
+	UCapsuleComponent* LiveCapsule{ CastChecked<UCapsuleComponent>(LiveRoot) };
+	LiveCapsule->SetCapsuleSize(40.0f, 90.0f);
+	LiveCapsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	LiveCapsule->SetCollisionResponseToChannel(ECollisionChannel::ECC_GameTraceChannel1, ECollisionResponse::ECR_Block);
+	LiveFighter->SetActorLocation(FVector{ 200.0, 0.0, 0.0 });
+
+	UFighterRegistrySubsystem* FighterRegistry{ World->GetSubsystem<UFighterRegistrySubsystem>() };
+	FighterRegistry->RegisterFighter(LiveFighter);
+
+	FTraceRecording Recording;
+	Recording.OwnerName = Attacker->GetName();
+
+	FTraceRecordedTarget& Target{ Recording.Targets.AddDefaulted_GetRef() };
+	Target.Name = TEXT("Dummy");
+	Target.CapsuleRadius = 40.0f;
+	Target.CapsuleHalfHeight = 90.0f;
+
+	// Window 1: two frames through the target, the second is deduplicated
+	Recording.Frames.Add(MakeFrame(true, 0.0, true));
+	Recording.Frames.Add(MakeFrame(false, 0.0, true));
+	// Window 2: hits again, then swings far away from it
+	Recording.Frames.Add(MakeFrame(true, 0.0, true));
+	Recording.Frames.Add(MakeFrame(false, 5000.0, true));
+	// Window 3: the target wasn't recorded near the weapon
+	Recording.Frames.Add(MakeFrame(true, 0.0, false));
+
+	// Round trip through the file format
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer{ Bytes };
+	Writer << Recording;
+
+	FTraceRecording Loaded;
+	FMemoryReader Reader{ Bytes };
+	Reader << Loaded;
+
+	TestFalse(TEXT("Recording loads"), Reader.IsError());
+	TestEqual(TEXT("Loaded frames"), Loaded.Frames.Num(), Recording.Frames.Num());
+	TestEqual(TEXT("Loaded targets"), Loaded.Targets.Num(), 1);
+	TestEqual(TEXT("Loaded owner"), Loaded.OwnerName, Recording.OwnerName);
+
+	// Truncated and corrupt files are rejected before their counts are trusted
+	TArray<uint8> Truncated{ Bytes };
+	Truncated.SetNum(Bytes.Num() / 2);
+	FTraceRecording Rejected;
+	TestFalse(TEXT("Truncated recording is rejected"), Rejected.LoadFromBytes(Truncated));
+
+	FTraceRecording Empty;
+	Empty.OwnerName = Recording.OwnerName;
+	TArray<uint8> EmptyBytes;
+	FMemoryWriter EmptyWriter{ EmptyBytes };
+	EmptyWriter << Empty;
+
+	// An empty recording ends with its target and frame counts
+	TArray<uint8> NegativeCount{ EmptyBytes };
+	const int32 Negative{ -1 };
+	FMemory::Memcpy(&NegativeCount[NegativeCount.Num() - 2 * sizeof(int32)], &Negative, sizeof(int32));
+	TestFalse(TEXT("Negative target count is rejected"), Rejected.LoadFromBytes(NegativeCount));
+
+	TArray<uint8> HugeCount{ EmptyBytes };
+	const int32 Huge{ MAX_int32 };
+	FMemory::Memcpy(&HugeCount[HugeCount.Num() - sizeof(int32)], &Huge, sizeof(int32));
+	TestFalse(TEXT("Frame count beyond the file size is rejected"), Rejected.LoadFromBytes(HugeCount));
+
+	TestTrue(TEXT("Empty recording loads"), Rejected.LoadFromBytes(EmptyBytes));
+
+	TestTrue(TEXT("Replay resolves the recorded owner"), Loaded.FindRecordedTraceComponent(World) == TraceComp);
+
+	FTraceRecording Orphan{ Loaded };
+	Orphan.OwnerName = TEXT("NotInThisWorld");
+	TestNull(TEXT("Replay doesn't substitute another actor"), Orphan.FindRecordedTraceComponent(World));
+
+	FTraceReplayReport Report;
+	TraceComp->ReplayRecording(Loaded, Report);
+
+	TestEqual(TEXT("Frames"), Report.Frames, 5);
+	TestEqual(TEXT("Windows"), Report.Windows, 3);
+	TestEqual(TEXT("Hits"), Report.Hits, 2);
+	TestEqual(TEXT("Sweeps"), Report.Sweeps, 3);
+	TestEqual(TEXT("Skipped sweeps"), Report.SkippedSweeps, 2);
+
+	// Same numbers every time, the replay leaves nothing behind
+	FTraceReplayReport SecondReport;
+	TraceComp->ReplayRecording(Loaded, SecondReport);
+
+	TestEqual(TEXT("Repeat hits"), SecondReport.Hits, Report.Hits);
+	TestEqual(TEXT("Repeat sweeps"), SecondReport.Sweeps, Report.Sweeps);
+
+	TArray<AActor*> RegisteredFighters;
+	FighterRegistry->GatherFighters(FVector::ZeroVector, UE_OLD_WORLD_MAX, RegisteredFighters);
+	TestEqual(TEXT("Only the live fighter is registered after the replay"), RegisteredFighters.Num(), 1);
+	TestTrue(TEXT("Live fighter is back in the registry"), RegisteredFighters.Contains(LiveFighter));
+
+	return true;
+}
+
+#endif
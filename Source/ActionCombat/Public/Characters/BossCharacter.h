@@ -7,6 +7,7 @@
 #include "Interfaces/Enemy.h"
 #include "Characters/EEnemyState.h"
 #include "Interfaces/Fighter.h"
+#include "Combat/CombatDamageEvent.h"
 #include "BossCharacter.generated.h"
 
 UCLASS()
@@ -54,6 +55,18 @@ private:
 
 	UAnimMontage* StunAnimMontage;
 
+	// Damage multipliers for head, limbs, tail, etc.
+	UPROPERTY(EditAnywhere, Category = "Combat")
+	class UBodyZoneTable* BodyZoneTable;
+
+	// Where the player's lock-on camera aims
+	UPROPERTY(EditAnywhere, Category = "Combat")
+	FName LockOnAimSocket;
+
+	// Forwards typed hits, which don't go through TakeDamage and the AnyDamage event, to Blueprint
+	UFUNCTION()
+	void HandleDamageReceived(FDamageResolution Resolution, AActor* DamageCauser);
+
 
 public:
 	// Sets default values for this character's properties
@@ -102,9 +115,19 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void StunCharacter(float Duration);
 
+	// Every hit resolved against the boss, including blocked and evaded ones (hurt flash, sounds)
+	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "Damage Resolved"))
+	void ReceiveDamageResolved(const FDamageResolution& Resolution, AActor* DamageCauser);
+
 	virtual bool IsBlocking() const override;
 	virtual bool IsParrying() const override;
 
+	virtual const UBodyZoneTable* GetBodyZoneTable() const override { return BodyZoneTable; }
+
+	virtual FName GetLockOnAimSocket() const override { return LockOnAimSocket; }
+
+	virtual UStatsComponent* GetStatsComponent() const override { return StatsComp; }
+
 	void CheckPlayerPosition();
 	void PerformRearAttack();
 	bool IsPlayerBehind() const;
@@ -14,11 +14,18 @@
 UENUM(BlueprintType)
 enum class EStat : uint8 
 {
-	None UMETA(DisplayName = "None Selected"),    // Default/invalid state
+	None UMETA(DisplayName = "None Selected", Hidden), // Default/invalid state, hidden from pickers and stat blocks
 	Health UMETA(DisplayName = "Vitality"),       // Current health value
 	MaxHealth UMETA(DisplayName = "Max Vitality"), // Maximum health capacity
 	Strength UMETA(DisplayName = "Might"),        // Character's attack power
 	Stamina UMETA(DisplayName = "Endurance"),     // Current stamina value
 	MaxStamina UMETA(DisplayName = "Max Endurance"), // Maximum stamina capacity
-	MeleeRange UMETA(DisplayName = "Melee Range") // Melee Range for Enemy
-};
\ No newline at end of file
+	MeleeRange UMETA(DisplayName = "Melee Range"), // Melee Range for Enemy
+	Count UMETA(Hidden)                            // Number of stats, new stats go above this
+};
+
+// Number of stats, sizes every stat block
+constexpr int32 NumStats{ static_cast<int32>(EStat::Count) };
+
+// Position of a stat in a stat block
+constexpr int32 StatIndex(EStat Stat) { return static_cast<int32>(Stat); }
\ No newline at end of file
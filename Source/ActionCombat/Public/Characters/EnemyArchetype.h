@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Characters/FStatBlock.h"
+#include "EnemyArchetype.generated.h"
+
+/**
+ * Base stats shared by every enemy of one kind.
+ * Stats components pointing at an archetype read MaxHealth, Strength, MeleeRange, etc. from here
+ * and only keep their own current Health and Stamina, which start at the archetype's values.
+ */
+UCLASS(BlueprintType)
+class ACTIONCOMBAT_API UEnemyArchetype : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FStatBlock BaseStats;
+
+#if WITH_EDITOR
+	// Lets live instances refresh their cached stats when the asset is edited during PIE
+	FSimpleMulticastDelegate OnArchetypeChanged;
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
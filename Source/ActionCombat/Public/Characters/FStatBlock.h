@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Characters/EStat.h"
+#include "FStatBlock.generated.h"
+
+/*
+ *	Flat, enum-indexed block of every character stat, sized by EStat::Count
+ *	Reading a stat is a direct array index, the details panel labels each entry with its EStat name
+ *	and skips the hidden None slot
+ */
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FStatBlock
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, meta = (ArraySizeEnum = "EStat"))
+	float Values[NumStats];
+
+	FStatBlock()
+	{
+		FMemory::Memzero(Values);
+	}
+
+	float& operator[](EStat Stat) { return Values[StatIndex(Stat)]; }
+	float operator[](EStat Stat) const { return Values[StatIndex(Stat)]; }
+};
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Characters/EStat.h"
+#include "FStatModifier.generated.h"
+
+/*
+ *	Buffs, debuffs, equipment and phase changes applied on top of a character's base stats
+ */
+
+UENUM(BlueprintType)
+enum class EStatModifierOp : uint8
+{
+	Additive,       // Added to the base value
+	Multiplicative  // Multiplies the base value plus every additive modifier
+};
+
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FStatModifier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EStat Stat{ EStat::None };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EStatModifierOp Op{ EStatModifierOp::Additive };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Value{ 0.0f };
+
+	// What applied the modifier (item, ability, boss phase...), used to remove it again
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName Source;
+
+	// Seconds until the modifier expires, 0 or less never expires
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Duration{ 0.0f };
+
+	// World time the modifier expires at, set when it is added
+	double ExpireTime{ 0.0 };
+};
@@ -6,6 +6,7 @@
 #include "GameFramework/Character.h"
 #include "Interfaces/MainPlayer.h"
 #include "Interfaces/Fighter.h"
+#include "Combat/CombatDamageEvent.h"
 #include "MainCharacter.generated.h"
 
 /*
@@ -28,7 +29,25 @@ private:
 	UPROPERTY(EditAnywhere)
 	UAnimMontage* HurtAnimMontage;
 
+	// Camera shake played with the hurt reaction, set it to the class the Blueprint used to pass to PlayHurtAnim
+	UPROPERTY(EditAnywhere)
+	TSubclassOf<UCameraShakeBase> HurtCameraShake;
+
+	// Damage multipliers for head, limbs, etc.
+	UPROPERTY(EditAnywhere)
+	class UBodyZoneTable* BodyZoneTable;
+
+	// Whether the player is holding block, used by every damage rule below
+	bool IsHoldingBlock() const;
+
+	// Damage rules shared by TakeDamage and the native resolver:
+	// whether the attack lands at all (evaded, parried) and how much a block takes off it
+	EDamageResult CheckDefenses(AActor* Attacker);
+	float ApplyBlock(float IncomingDamage, AActor* Attacker, EDamageResult& OutResult);
 
+	// Plays the hurt reaction for typed hits, which don't go through TakeDamage and the AnyDamage event
+	UFUNCTION()
+	void HandleDamageReceived(FDamageResolution Resolution, AActor* DamageCauser);
 	
 
 public:
@@ -90,6 +109,10 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void PlayHurtAnim(TSubclassOf<UCameraShakeBase> CameraShakeTemplate);
 
+	// Every typed hit resolved against the player after the native hurt reaction, including blocked and evaded ones
+	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "Damage Resolved"))
+	void ReceiveDamageResolved(const FDamageResolution& Resolution, AActor* DamageCauser);
+
 	UFUNCTION()
 	float CalculateReceivedDamage(float IncomingDamage, AActor* DamageCauser);
 
@@ -101,4 +124,11 @@ public:
 	virtual bool IsBlocking() const override;
 	virtual bool IsParrying() const override;
 	virtual bool IsBlockFailed() const override;
+
+	virtual const UBodyZoneTable* GetBodyZoneTable() const override { return BodyZoneTable; }
+
+	virtual void ResolveIncomingDamage(const FCombatDamageEvent& DamageEvent, AActor* Attacker,
+		FDamageResolution& OutResolution) override;
+
+	virtual UStatsComponent* GetStatsComponent() const override { return StatsComp; }
 };
\ No newline at end of file
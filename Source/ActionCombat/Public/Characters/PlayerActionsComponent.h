@@ -38,6 +38,9 @@ private:
 	// Interface reference for player functionality
 	class IMainPlayer* IPlayerRef;
 
+	// Holds rolls pressed during an attack until it can be cancelled
+	class UCombatComponent* CombatComp{ nullptr };
+
 	// Reference to movement component for speed control
 	class UCharacterMovementComponent* MovementComp;
 
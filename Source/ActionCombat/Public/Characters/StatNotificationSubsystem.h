@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatNotificationSubsystem.generated.h"
+
+class UStatsComponent;
+
+/**
+ * Flushes stat change notifications once per frame.
+ * Stats components queue themselves when a stat changes and are told to broadcast their final values here,
+ * so several changes in one frame reach UI bindings as a single update.
+ * The flush runs after the world's post actor tick, once actors, timers and tickable subsystems (hit batch,
+ * status effects) have made their changes, so damage resolved late in the frame still goes out that frame.
+ */
+UCLASS()
+class ACTIONCOMBAT_API UStatNotificationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	TArray<TWeakObjectPtr<UStatsComponent>> PendingComponents;
+
+	// Batch being flushed, kept around so its allocation is reused every frame
+	TArray<TWeakObjectPtr<UStatsComponent>> FlushingComponents;
+
+	FDelegateHandle PostActorTickHandle;
+
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Queues the component for this frame's flush, callers make sure it is only queued once
+	void QueueFlush(UStatsComponent* Component);
+
+	// Has every queued component broadcast its final values
+	void Flush();
+};
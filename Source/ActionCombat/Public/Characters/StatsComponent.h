@@ -4,6 +4,9 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Characters/EStat.h"
+#include "Characters/FStatBlock.h"
+#include "Characters/FStatModifier.h"
+#include "Combat/CombatDamageEvent.h"
 #include "StatsComponent.generated.h"
 
 /*
@@ -28,6 +31,16 @@ DECLARE_DYNAMIC_MULTICAST_SPARSE_DELEGATE(
     UStatsComponent, OnZeroHealthDelegate
     );
 
+DECLARE_DYNAMIC_MULTICAST_SPARSE_DELEGATE_TwoParams(
+    FOnDamageReceivedSignature,
+    UStatsComponent, OnDamageReceivedDelegate,
+    FDamageResolution, Resolution,
+    AActor*, DamageCauser
+);
+
+// Native counterpart of the percent delegates for C++ listeners, fired with the stat that changed
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnStatPercentChangedNative, EStat /* Stat */, float /* Percentage */);
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class ACTIONCOMBAT_API UStatsComponent : public UActorComponent
 {
@@ -41,17 +54,113 @@ class ACTIONCOMBAT_API UStatsComponent : public UActorComponent
     UPROPERTY(VisibleAnywhere)
     bool bCanRegen{ true };
 
+    // Turns stamina regeneration on or off entirely, independent of the delay after spending
+    UPROPERTY(EditAnywhere)
+    bool bStaminaRegenEnabled{ true };
+
+    // Smallest change in stamina percentage (0-1) worth broadcasting to the UI
+    UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float StaminaBroadcastThreshold{ 0.005f };
+
+    // Stamina percentage the UI was last told about
+    float LastBroadcastStaminaPercent{ -1.0f };
+
+    // World time the current regeneration delay ends, spending stamina pushes it back
+    double RegenDelayEndTime{ 0.0 };
+
+    // Armed once per delay, re-arms itself if the delay was pushed back while it waited
+    FTimerHandle RegenDelayTimerHandle;
+
+    void HandleRegenDelayTimer();
+
     // Time to wait after stamina use before regeneration begins
     UPROPERTY(EditAnywhere)
     float StaminaDelayDuration{ 2.0f };
 
+    // Active modifiers on top of the base stats
+    UPROPERTY(VisibleAnywhere)
+    TArray<FStatModifier> Modifiers;
+
+    // Base stats with modifiers applied, indexed by EStat and only recomputed for stats marked dirty
+    // Left empty while no modifier is active, GetStat then reads the base stats directly
+    mutable TArray<float> FinalStats;
+
+    // One bit per stat whose final value is out of date
+    mutable uint32 DirtyStats{ ~0u };
+
+    // Current Health and Stamina, the only stats an instance with an archetype keeps for itself
+    // Start at the base stats' values in BeginPlay
+    UPROPERTY(VisibleInstanceOnly)
+    float CurrentHealth{ 0.0f };
+
+    UPROPERTY(VisibleInstanceOnly)
+    float CurrentStamina{ 0.0f };
+
+    static_assert(NumStats <= 32, "DirtyStats needs one bit per stat");
+
+    // Fires when the next timed modifier expires, one timer no matter how many modifiers there are
+    FTimerHandle ModifierExpiryTimerHandle;
+
+    void MarkStatDirty(EStat Stat);
+
+    // Health and Stamina change during play and are always stored per instance
+    static bool IsResourceStat(EStat Stat) { return Stat == EStat::Health || Stat == EStat::Stamina; }
+
+    float& GetResource(EStat Stat) { return Stat == EStat::Health ? CurrentHealth : CurrentStamina; }
+    float GetResource(EStat Stat) const { return Stat == EStat::Health ? CurrentHealth : CurrentStamina; }
+
+    // Archetype's base stats when one is set, the component's own otherwise
+    const FStatBlock& GetBaseStatBlock() const;
+
+    // Base value before modifiers, from the archetype unless it's a resource stat
+    float GetBaseStat(EStat Stat) const;
+
+#if WITH_EDITOR
+    FDelegateHandle ArchetypeChangedHandle;
+
+    // Archetype edited during PIE, every cached final value is out of date and the max stats may have dropped
+    void HandleArchetypeChanged();
+#endif
+
+    // Ticks only while stamina is below max and allowed to regenerate
+    void UpdateRegenTick();
+
+    // Change notifications waiting for the end of the frame
+    bool bHealthChangePending{ false };
+    bool bStaminaChangePending{ false };
+    bool bFlushQueued{ false };
+
+    class UStatNotificationSubsystem* NotificationSubsystem{ nullptr };
+
+    // Marks the stat's percentage as changed, it is broadcast once when the frame's changes are flushed
+    void QueueChangeNotification(EStat Stat);
+
+    void ScheduleModifierExpiry();
+
+    // A modifier on a max stat changed, keeps the matching resource within the new max
+    void HandleMaxStatModified(EStat Stat);
+
+    void HandleModifierExpiry();
+
+    void ReleaseFinalStatsIfUnmodified();
+
 public:    
     // Constructor - sets default component properties
     UStatsComponent();
 
-    // Map containing all character statistics and their current values
+    // Shared base stats for enemies of one kind, when set the component's own StatBlock is ignored
     UPROPERTY(EditAnywhere)
-    TMap<EStat, float> Stats;
+    class UEnemyArchetype* Archetype{ nullptr };
+
+    // Base values of all character statistics, indexed by EStat, for characters without an archetype
+    UPROPERTY(EditAnywhere, meta = (EditCondition = "Archetype == nullptr"))
+    FStatBlock StatBlock;
+
+#if WITH_EDITORONLY_DATA
+    // Stats saved before the stat block existed, moved into StatBlock on load
+    UPROPERTY()
+    TMap<EStat, float> Stats_DEPRECATED;
+#endif
 
     UPROPERTY(BlueprintAssignable)
     FOnHealthPercentUpdateSignature OnHealthPercentUpdateDelegate;
@@ -61,30 +170,74 @@ public:
     
     UPROPERTY(BlueprintAssignable)   
     FOnZeroHealthSignature OnZeroHealthDelegate;
+
+    FOnStatPercentChangedNative OnStatPercentChangedNative;
+
+    // Fired for every typed hit resolved against the owner, including blocked, parried and evaded ones (hurt reactions)
+    UPROPERTY(BlueprintAssignable)
+    FOnDamageReceivedSignature OnDamageReceivedDelegate;
+
+    // Broadcasts the final percentages of every stat that changed since the last flush
+    void FlushChangeNotifications();
 protected:
     // Initialization when game starts
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Migrates data saved with the old stats map
+    virtual void PostLoad() override;
+
 public:    
     // Update function called every frame
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
     // Reduces character's health by the specified amount
+    // Damage that can't be defended against (status effects) skips the owner's CanTakeDamage check
     UFUNCTION(BlueprintCallable)
-    void ReduceHealth(float Amount, AActor* Opponent);
+    void ReduceHealth(float Amount, AActor* Opponent, bool bSkipDefenseCheck = false);
+
+    // Applies a hit already resolved against the owner's defenses by FDamageResolver
+    void ApplyResolvedDamage(const FDamageResolution& Resolution, AActor* DamageCauser);
 
     // Reduces character's stamina and triggers regeneration delay
     UFUNCTION(BlueprintCallable)
     void ReduceStamina(float Amount);
     
-    // Handles gradual stamina regeneration
-    UFUNCTION(BlueprintCallable)
+    // Stamina regenerates natively now, kept so existing Blueprint calls keep compiling
+    UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Stamina regenerates on its own, remove this call"))
     void RegenStamina();
 
+    UFUNCTION(BlueprintCallable)
+    void SetStaminaRegenEnabled(bool bEnabled);
+
     // Enables stamina regeneration after delay period
     UFUNCTION()
     void EnableRegen();
 
+    // Seconds left before stamina starts regenerating, 0 when it isn't delayed
+    UFUNCTION(BlueprintPure)
+    float GetRegenDelayRemaining() const;
+
+    UFUNCTION(BlueprintPure)
+    bool IsRegenDelayed() const { return !bCanRegen; }
+
     UFUNCTION(BlueprintPure)
     float GetStatPercentage(EStat Current, EStat Max);
+
+    // Value of the stat with every active modifier applied
+    UFUNCTION(BlueprintPure)
+    float GetStat(EStat Stat) const;
+
+    // Sets the base value of the stat, stats coming from an archetype can only be changed with modifiers (logs a warning)
+    UFUNCTION(BlueprintCallable)
+    void SetStat(EStat Stat, float Value);
+
+    // Health and Stamina are spent and regenerated directly, so modifiers on them are rejected; modify MaxHealth/MaxStamina instead
+    UFUNCTION(BlueprintCallable)
+    void AddModifier(const FStatModifier& Modifier);
+
+    // Removes every modifier applied by Source, returns how many were removed
+    UFUNCTION(BlueprintCallable)
+    int32 RemoveModifiersFromSource(FName Source);
 };
\ No newline at end of file
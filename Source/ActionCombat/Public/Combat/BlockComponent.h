@@ -54,6 +54,9 @@ private:
 
 	FTimerHandle ParryWindowTimerHandle;
 
+	// Holds blocks raised during an attack until it can be cancelled
+	class UCombatComponent* CombatComp{ nullptr };
+
 	
 	
 public:	
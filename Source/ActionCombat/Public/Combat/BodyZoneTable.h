@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Combat/EBodyZone.h"
+#include "BodyZoneTable.generated.h"
+
+/**
+ * Locational damage setup for one skeletal mesh.
+ * Bones are authored by name, and bones that aren't listed inherit the zone of their closest listed parent.
+ * On load the table is compiled into a bone-index-keyed array so a hit's zone and multiplier are plain array reads.
+ */
+UCLASS(BlueprintType)
+class ACTIONCOMBAT_API UBodyZoneTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+	// Mesh the bone indices are compiled against
+	UPROPERTY(EditAnywhere)
+	USkeletalMesh* Mesh;
+
+	// Zone of each listed bone and its children
+	UPROPERTY(EditAnywhere)
+	TMap<FName, EBodyZone> BoneZones;
+
+	// Damage multiplier of each zone (unlisted zones deal normal damage)
+	UPROPERTY(EditAnywhere)
+	TMap<EBodyZone, float> ZoneMultipliers;
+
+	// Compiled zone of every bone in the mesh's reference skeleton
+	TArray<EBodyZone> BoneIndexToZone;
+
+	float ZoneMultiplierTable[static_cast<int32>(EBodyZone::Count)];
+
+public:
+	UBodyZoneTable();
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Rebuilds the bone index and multiplier arrays from the authored maps
+	void Compile();
+
+	// Zone of the bone a sweep hit, Default for capsule hits or other meshes
+	EBodyZone ResolveHitZone(const FHitResult& Hit) const;
+
+	float GetMultiplier(EBodyZone Zone) const
+	{
+		return ZoneMultiplierTable[static_cast<int32>(Zone)];
+	}
+};
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Combat/ECombatInput.h"
+#include "Combat/ComboGraph.h"
 #include "CombatComponent.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_SPARSE_DELEGATE_OneParam(
@@ -22,6 +24,21 @@ private:
 	UPROPERTY(EditAnywhere)
 	 TArray<UAnimMontage*> AttackAnimations;
 
+	// Branching combo, replaces the AttackAnimations sequence when set
+	UPROPERTY(EditAnywhere)
+	UComboGraph* ComboGraph;
+
+	// Attack of the combo graph that played last, INDEX_NONE when no combo is running
+	UPROPERTY(VisibleAnywhere)
+	int32 CurrentComboAttack{ INDEX_NONE };
+
+	// Presses coming this long after the cancel point use the graph's delayed transitions
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float DelayedAttackThreshold{ 0.4f };
+
+	// World time the current attack could first be cancelled
+	double CancelPointTime{ 0.0 };
+
 	ACharacter* CharacterRef;
 
 	UPROPERTY(VisibleAnywhere)
@@ -38,7 +55,67 @@ private:
 
 	FTimerHandle ComboResetTimerHandle;
 
+	class ULockOnComponent* LockOnComp;
+
+	// Aim assist: when not locked on, attacks turn toward the best enemy within this range and cone
+	UPROPERTY(EditAnywhere)
+	float SoftTargetRange{ 400.0f };
+
+	// Half angle of the soft targeting cone in front of the character
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0", ClampMax = "180.0"))
+	float SoftTargetConeAngle{ 60.0f };
+
+	// Seconds at the start of an attack spent turning toward the soft target
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float SoftTargetTurnTime{ 0.2f };
+
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float SoftTargetTurnSpeed{ 15.0f };
+
+	TWeakObjectPtr<AActor> SoftTarget;
+	float SoftTargetTurnTimeRemaining{ 0.0f };
+
+	// Picks the enemy to turn toward for this attack, if any
+	void AcquireSoftTarget();
+
+	class UPlayerActionsComponent* PlayerActionsComp;
+
+	class UBlockComponent* BlockComp;
+
+	// Presses older than this when the attack can be cancelled are dropped
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float InputBufferWindow{ 0.5f };
+
+	// Latest press made while attacking, the newest press replaces an older one
+	ECombatInput BufferedInput{ ECombatInput::None };
+
+	// World time of the buffered press, checked against the buffer window
+	double BufferedInputTime{ 0.0 };
 
+	// Real time of the buffered press, used to measure latency
+	double BufferedInputRealTime{ 0.0 };
+
+	// Which attack a buffered attack press was
+	EComboInput BufferedComboInput{ EComboInput::Light };
+	EComboInputVariant BufferedComboVariant{ EComboInputVariant::Tap };
+
+	// Time between the last press and the montage it started
+	UPROPERTY(VisibleAnywhere)
+	float LastInputLatency{ 0.0f };
+
+	// Starts the next attack of the combo, PressTime is the real time the press happened.
+	// bFromBuffer skips the bCanAttack check, buffered presses are performed right at the cancel point
+	void StartComboAttack(EComboInput Input, EComboInputVariant Variant, double PressTime, bool bFromBuffer = false);
+
+	// Next montage of the AttackAnimations sequence, used without a combo graph
+	UAnimMontage* AdvanceAttackSequence();
+
+	// Performs the buffered press, if it is still recent enough
+	void ConsumeBufferedInput();
+
+	void RecordInputLatency(double PressTime);
+
+	
 	
 public:	
 	// Sets default values for this component's properties
@@ -57,14 +134,37 @@ public:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// Light attack tap
 	UFUNCTION(BlueprintCallable)
 	void ComboAttack();
 
+	// Continues the combo graph with a light or heavy attack, bHeld when the button was held down
+	UFUNCTION(BlueprintCallable)
+	void ComboAttackWithInput(EComboInput Input, bool bHeld);
+
+	// Cancel point of the current attack, performs any buffered press
 	UFUNCTION(BlueprintCallable)
 	void HandleResetAttack();
 
+	// Holds the press until the current attack can be cancelled. Returns false if nothing is
+	// playing and the caller should perform the action right away
+	UFUNCTION(BlueprintCallable)
+	bool BufferInput(ECombatInput Input);
+
+	// Drops a buffered press, e.g. when block is released before it could start
+	UFUNCTION(BlueprintCallable)
+	void CancelBufferedInput(ECombatInput Input);
+
+	// Seconds between the last attack, roll or block press and its montage starting
+	UFUNCTION(BlueprintPure)
+	float GetLastInputLatency() const { return LastInputLatency; }
+
 	void RandomAttack();
 
 	UFUNCTION()
 	void ResetCombo();
+
+	// Stops the current attack (e.g. on stagger), drops buffered presses and starts the next combo over
+	UFUNCTION(BlueprintCallable)
+	void InterruptAttack();
 };
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DamageEvents.h"
+#include "Combat/EBodyZone.h"
+#include "Combat/EHitEffectType.h"
+#include "Combat/EStatusEffectType.h"
+#include "CombatDamageEvent.generated.h"
+
+/*
+ *	Typed damage passed from weapons and projectiles to the native damage resolver
+ */
+
+UENUM(BlueprintType)
+enum class ECombatDamageType : uint8
+{
+	Melee       UMETA(DisplayName = "Melee"),
+	Projectile  UMETA(DisplayName = "Projectile")
+};
+
+// How an attack landed on its target
+UENUM(BlueprintType)
+enum class EDamageResult : uint8
+{
+	Applied   UMETA(DisplayName = "Applied"),   // Full damage
+	Blocked   UMETA(DisplayName = "Blocked"),   // Reduced damage
+	Parried   UMETA(DisplayName = "Parried"),   // No damage, attacker punished
+	Evaded    UMETA(DisplayName = "Evaded")     // No damage (i-frames)
+};
+
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FCombatDamageEvent : public FDamageEvent
+{
+	GENERATED_BODY()
+
+	// Same for every hit of one swing or projectile, see FDamageResolver::NewAttackId
+	UPROPERTY(BlueprintReadWrite)
+	int32 AttackId{ INDEX_NONE };
+
+	// Damage before the target's defenses, zone multiplier included
+	UPROPERTY(BlueprintReadWrite)
+	float Damage{ 0.0f };
+
+	UPROPERTY(BlueprintReadWrite)
+	ECombatDamageType CombatDamageType{ ECombatDamageType::Melee };
+
+	UPROPERTY(BlueprintReadWrite)
+	EBodyZone Zone{ EBodyZone::Default };
+
+	// Direction the attack travelled when it hit
+	UPROPERTY(BlueprintReadWrite)
+	FVector HitDirection{ FVector::ZeroVector };
+
+	UPROPERTY(BlueprintReadWrite)
+	FVector ImpactPoint{ FVector::ZeroVector };
+
+	// Applied by the resolver when the hit isn't blocked, parried or evaded
+	UPROPERTY(BlueprintReadWrite)
+	FStatusEffectOnHit StatusEffect;
+
+	// Point = 1 and Radial = 2 are taken by the engine
+	static const int32 ClassID{ 3 };
+
+	virtual int32 GetTypeID() const override { return FCombatDamageEvent::ClassID; }
+	virtual bool IsOfType(int32 InID) const override
+	{
+		return (FCombatDamageEvent::ClassID == InID) || FDamageEvent::IsOfType(InID);
+	}
+};
+
+// Outcome of one attack against its target's defenses
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FDamageResolution
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	EDamageResult Result{ EDamageResult::Applied };
+
+	// Damage left after the target's defenses
+	UPROPERTY(BlueprintReadOnly)
+	float FinalDamage{ 0.0f };
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 AttackId{ INDEX_NONE };
+
+	UPROPERTY(BlueprintReadOnly)
+	EBodyZone Zone{ EBodyZone::Default };
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector HitDirection{ FVector::ZeroVector };
+
+	EHitEffectType GetHitEffectType() const
+	{
+		switch (Result)
+		{
+			case EDamageResult::Blocked: return EHitEffectType::Block;
+			case EDamageResult::Parried: return EHitEffectType::Parry;
+			default: return EHitEffectType::Normal;
+		}
+	}
+};
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Combat/EHitEffectType.h"
+#include "Combat/EBodyZone.h"
+#include "Combat/EStatusEffectType.h"
+#include "CombatHitBatchSubsystem.generated.h"
+
+class UTraceComponent;
+
+// One weapon hit waiting for the end-of-frame damage pass
+struct ACTIONCOMBAT_API FCombatHit
+{
+	TWeakObjectPtr<AActor> Attacker;
+	TWeakObjectPtr<AActor> Target;
+
+	// Trace that registered the hit, provides the hit effect templates
+	TWeakObjectPtr<UTraceComponent> Source;
+
+	FVector ImpactPoint{ FVector::ZeroVector };
+	float Damage{ 0.0f };
+
+	// Swing the hit belongs to and the direction the blade was moving
+	int32 AttackId{ INDEX_NONE };
+	FVector HitDirection{ FVector::ZeroVector };
+
+	// Body area that was hit and its damage multiplier, resolved when the hit was registered
+	EBodyZone Zone{ EBodyZone::Default };
+	float ZoneMultiplier{ 1.0f };
+
+	// Left on the target if the hit lands undefended
+	FStatusEffectOnHit StatusEffect;
+
+	// Filled in by the damage pass from how the target defended
+	EHitEffectType EffectType{ EHitEffectType::Normal };
+};
+
+/**
+ * Collects every weapon hit registered during a frame and resolves them together once all traces have run.
+ * Hits are resolved in a fixed order (by attacker, then target) so trades on the same frame always play out the same way,
+ * damage is resolved natively against each target's defenses, and hit effects run as a separate pass afterwards.
+ */
+UCLASS()
+class ACTIONCOMBAT_API UCombatHitBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	TArray<FCombatHit> PendingHits;
+
+	// Batch being resolved, kept around so its allocation is reused every frame
+	TArray<FCombatHit> ResolvingHits;
+
+public:
+	// Queues a hit for this frame's damage pass
+	void QueueHit(FCombatHit&& Hit);
+
+	// Resolves all queued hits
+	void ResolveHits();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+};
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ComboGraph.generated.h"
+
+UENUM(BlueprintType)
+enum class EComboInput : uint8
+{
+	Light  UMETA(DisplayName = "Light Attack"),
+	Heavy  UMETA(DisplayName = "Heavy Attack"),
+	Count  UMETA(Hidden)
+};
+
+// How the attack button was pressed
+UENUM(BlueprintType)
+enum class EComboInputVariant : uint8
+{
+	Tap      UMETA(DisplayName = "Tap"),
+	// Button held down before release
+	Hold     UMETA(DisplayName = "Hold"),
+	// Pressed after a pause, once the previous attack could already be cancelled
+	Delayed  UMETA(DisplayName = "Delayed"),
+	Count    UMETA(Hidden)
+};
+
+// Columns of the compiled transition table, one per input and variant
+constexpr int32 NumComboInputs{ static_cast<int32>(EComboInput::Count) * static_cast<int32>(EComboInputVariant::Count) };
+
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FComboTransition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	EComboInput Input{ EComboInput::Light };
+
+	UPROPERTY(EditAnywhere)
+	EComboInputVariant Variant{ EComboInputVariant::Tap };
+
+	// Name of the attack this input leads to
+	UPROPERTY(EditAnywhere)
+	FName Next;
+};
+
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FComboAttack
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	FName Name;
+
+	UPROPERTY(EditAnywhere)
+	UAnimMontage* Montage{ nullptr };
+
+	// Ends the combo, the next press starts over from the graph's start transitions
+	UPROPERTY(EditAnywhere)
+	bool bFinisher{ false };
+
+	// Relative chance of AI picking this attack when choosing randomly, 0 never picks it
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float RandomWeight{ 1.0f };
+
+	UPROPERTY(EditAnywhere)
+	TArray<FComboTransition> Transitions;
+};
+
+/**
+ * Branching combo authored as named attacks linked by inputs.
+ * On load the graph is compiled into a flat table with a row per attack (plus one for starting a combo)
+ * and a column per input, so finding the next attack is a single array read.
+ * Missing hold and delayed transitions fall back to the tap transition, and inputs an attack has no
+ * transition for restart the combo from the start transitions.
+ */
+UCLASS(BlueprintType)
+class ACTIONCOMBAT_API UComboGraph : public UDataAsset
+{
+	GENERATED_BODY()
+
+	// Attacks a combo can open with
+	UPROPERTY(EditAnywhere)
+	TArray<FComboTransition> StartTransitions;
+
+	UPROPERTY(EditAnywhere)
+	TArray<FComboAttack> Attacks;
+
+	// Next attack index for each row and input, row 0 is the start of a combo
+	TArray<int32> TransitionTable;
+
+	// Random choices of each row are RandomChoices[RandomChoiceOffsets[Row]] up to the next row's offset
+	TArray<int32> RandomChoiceOffsets;
+	TArray<int32> RandomChoices;
+
+	// Running total of the random weights within each row
+	TArray<float> RandomCumulativeWeights;
+
+	static int32 GetRow(int32 AttackIndex) { return AttackIndex + 1; }
+
+	static int32 GetColumn(EComboInput Input, EComboInputVariant Variant)
+	{
+		return static_cast<int32>(Input) * static_cast<int32>(EComboInputVariant::Count) + static_cast<int32>(Variant);
+	}
+
+public:
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Rebuilds the transition and random choice tables from the authored attacks
+	void Compile();
+
+	// Attack that follows AttackIndex (INDEX_NONE when no combo is running), INDEX_NONE if the input leads nowhere
+	int32 GetNextAttack(int32 AttackIndex, EComboInput Input, EComboInputVariant Variant) const
+	{
+		int32 TableIndex{ GetRow(AttackIndex) * NumComboInputs + GetColumn(Input, Variant) };
+		return TransitionTable.IsValidIndex(TableIndex) ? TransitionTable[TableIndex] : INDEX_NONE;
+	}
+
+	// Weighted random pick among the attacks that can follow AttackIndex
+	int32 PickRandomAttack(int32 AttackIndex) const;
+
+	const FComboAttack& GetAttack(int32 AttackIndex) const { return Attacks[AttackIndex]; }
+
+	bool IsValidAttack(int32 AttackIndex) const { return Attacks.IsValidIndex(AttackIndex); }
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/CombatDamageEvent.h"
+
+/**
+ * Native damage path for weapon and projectile hits.
+ * The target's defenses (i-frames, parry, block and its reduction) are worked out once through IFighter,
+ * and the result is applied straight to its stats component, without going through AActor::TakeDamage and Blueprint.
+ * Targets that aren't fighters still receive the event through TakeDamage.
+ */
+class ACTIONCOMBAT_API FDamageResolver
+{
+public:
+	// Resolves the attack against the target's defenses and applies the damage that is left
+	static FDamageResolution ApplyDamage(AActor* Target, AActor* Attacker, const FCombatDamageEvent& DamageEvent);
+
+	// Unique id for a new swing or projectile
+	static int32 NewAttackId();
+};
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EBodyZone.generated.h"
+
+/*
+ *	Body area a weapon hit landed on, used for locational damage and hit effects
+ */
+
+UENUM(BlueprintType)
+enum class EBodyZone : uint8
+{
+	Default UMETA(DisplayName = "Default"),   // Capsule hits and bones with no zone
+	Head    UMETA(DisplayName = "Head"),
+	Torso   UMETA(DisplayName = "Torso"),
+	Arms    UMETA(DisplayName = "Arms"),
+	Legs    UMETA(DisplayName = "Legs"),
+	Tail    UMETA(DisplayName = "Tail"),
+	Count   UMETA(Hidden)
+};
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ECombatInput.generated.h"
+
+/*
+ *	Player action that can be held in the combat input buffer until the current attack can be cancelled
+ */
+
+UENUM(BlueprintType)
+enum class ECombatInput : uint8
+{
+	None    UMETA(DisplayName = "None"),
+	Attack  UMETA(DisplayName = "Attack"),
+	Roll    UMETA(DisplayName = "Roll"),
+	Block   UMETA(DisplayName = "Block")
+};
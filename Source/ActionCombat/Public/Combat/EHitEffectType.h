@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EHitEffectType.generated.h"
+
+/*
+ *	Kind of impact a weapon or projectile hit produced, used to pick the hit effect
+ */
+
+UENUM(BlueprintType)
+enum class EHitEffectType : uint8
+{
+	Normal  UMETA(DisplayName = "Normal Hit"),
+	Block   UMETA(DisplayName = "Block"),
+	Parry   UMETA(DisplayName = "Parry")
+};
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EStatusEffectType.generated.h"
+
+/*
+ *	Lingering effects a hit can leave on a character
+ */
+
+UENUM(BlueprintType)
+enum class EStatusEffectType : uint8
+{
+	Bleed   UMETA(DisplayName = "Bleed"),    // Damage over time
+	Poison  UMETA(DisplayName = "Poison"),   // Damage over time
+	Stagger UMETA(DisplayName = "Stagger")   // No damage, interrupts the target's current attack when applied
+};
+
+// Effect a weapon or projectile leaves on the target when its hit lands undefended
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FStatusEffectOnHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EStatusEffectType Type{ EStatusEffectType::Bleed };
+
+	// Seconds the effect lasts, 0 leaves no effect
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float Duration{ 0.0f };
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float DamagePerSecond{ 0.0f };
+
+	bool IsSet() const { return Duration > 0.0f; }
+};
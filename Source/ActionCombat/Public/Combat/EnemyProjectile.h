@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Combat/EStatusEffectType.h"
 #include "EnemyProjectile.generated.h"
 
 UCLASS()
@@ -14,8 +15,16 @@ class ACTIONCOMBAT_API AEnemyProjectile : public AActor
 	UPROPERTY(EditAnywhere)
 	UParticleSystem* HitTemplate;
 
+	// Impact effects kept ready in the world's hit effect pool
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0"))
+	int32 HitEffectPrewarmCount{ 2 };
+
 	UPROPERTY(EditAnywhere)
 	float Damage{ 10.0f };
+
+	// e.g. poison left on the player when the projectile isn't blocked
+	UPROPERTY(EditAnywhere)
+	FStatusEffectOnHit StatusEffectOnHit;
 	
 public:	
 	// Sets default values for this actor's properties
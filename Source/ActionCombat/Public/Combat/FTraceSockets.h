@@ -23,3 +23,33 @@ struct ACTIONCOMBAT_API FTraceSockets
 	UPROPERTY(EditAnywhere)
 	FName Rotation;
 };
+
+// Socket or bone resolved to a bone index plus the socket's offset from that bone
+struct ACTIONCOMBAT_API FResolvedTraceSocket
+{
+	int32 BoneIndex{ INDEX_NONE };
+	FTransform LocalOffset{ FTransform::Identity };
+
+	bool IsValid() const { return BoneIndex != INDEX_NONE; }
+};
+
+// Cached lookup of an FTraceSockets entry, built once per skeletal mesh
+struct ACTIONCOMBAT_API FResolvedTraceSockets
+{
+	FResolvedTraceSocket Start;
+	FResolvedTraceSocket End;
+	FResolvedTraceSocket Rotation;
+
+	bool IsValid() const { return Start.IsValid() && End.IsValid() && Rotation.IsValid(); }
+};
+
+// World-space pose of one trace socket pair sampled on a single frame
+struct ACTIONCOMBAT_API FTraceSocketPose
+{
+	FVector Start{ FVector::ZeroVector };
+	FVector End{ FVector::ZeroVector };
+	FQuat Rotation{ FQuat::Identity };
+
+	// Blends between two poses, rotating the blade around its start point instead of cutting the chord
+	static FTraceSocketPose Interpolate(const FTraceSocketPose& From, const FTraceSocketPose& To, float Alpha);
+};
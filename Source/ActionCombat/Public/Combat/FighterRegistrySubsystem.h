@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FighterRegistrySubsystem.generated.h"
+
+/**
+ * World-level registry of every IFighter and IEnemy actor, bucketed into a uniform 2D grid by capsule bounds.
+ * Actors implementing either interface are registered when they spawn (or when play begins for placed ones)
+ * and leave the registry when their play ends, whether they are native or Blueprint classes.
+ * Entries are moved between cells only when their root component moves across a cell boundary,
+ * so weapon traces can cheaply ask whether any fighter is near a sweep before running a physics query.
+ */
+
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FFighterRegistryStats
+{
+	GENERATED_BODY()
+
+	// Overlap queries answered by the registry
+	UPROPERTY(BlueprintReadOnly)
+	int32 Queries{ 0 };
+
+	// Queries that found no fighter, each one is a physics sweep that was skipped
+	UPROPERTY(BlueprintReadOnly)
+	int32 Rejected{ 0 };
+
+	// Times a fighter moved into a different set of cells
+	UPROPERTY(BlueprintReadOnly)
+	int32 CellUpdates{ 0 };
+};
+
+UCLASS()
+class ACTIONCOMBAT_API UFighterRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FFighterEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TWeakObjectPtr<USceneComponent> Root;
+		FBox Bounds{ ForceInit };
+		FIntPoint MinCell{ 0, 0 };
+		FIntPoint MaxCell{ -1, -1 };
+		FDelegateHandle MovedHandle;
+	};
+
+	// Sparse so entry indices stored in the cells stay valid when fighters unregister
+	TSparseArray<FFighterEntry> Fighters;
+
+	TMap<const AActor*, int32> ActorToEntry;
+
+	// Entry indices of the fighters whose bounds touch each cell
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	mutable FFighterRegistryStats Stats;
+
+	// Edge length of a grid cell, roughly a couple of character capsules
+	static constexpr double CellSize{ 400.0 };
+
+	// Added around the capsule so limbs, weapons and tails reaching outside it still count
+	static constexpr double BoundsPadding{ 150.0 };
+
+	// Boxes covering more cells than this just test every fighter
+	static constexpr int32 MaxCellsPerQuery{ 64 };
+
+	static FIntPoint ToCell(const FVector& Location);
+
+	void AddToCells(int32 EntryIndex);
+	void RemoveFromCells(int32 EntryIndex);
+
+	void HandleFighterMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+		ETeleportType Teleport, int32 EntryIndex);
+
+	FDelegateHandle ActorSpawnedHandle;
+
+	// Registers the actor if it implements IFighter or IEnemy
+	void RegisterIfFighter(AActor* Actor);
+
+	UFUNCTION()
+	void HandleFighterEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	void RegisterFighter(AActor* Fighter);
+	void UnregisterFighter(AActor* Fighter);
+
+	// True if any registered fighter other than IgnoredActor has bounds touching the box
+	bool AnyFighterOverlaps(const FBox& Box, const AActor* IgnoredActor = nullptr) const;
+
+	// Appends every registered fighter other than IgnoredActor whose bounds come within Radius of Center
+	void GatherFighters(const FVector& Center, double Radius, TArray<AActor*>& OutFighters,
+		const AActor* IgnoredActor = nullptr) const;
+
+	UFUNCTION(BlueprintPure)
+	FFighterRegistryStats GetStats() const { return Stats; }
+};
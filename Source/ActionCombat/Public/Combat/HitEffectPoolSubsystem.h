@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Combat/EHitEffectType.h"
+#include "HitEffectPoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/**
+ * World-level pool of hit, block and parry particle components.
+ * Components are created once (ideally while the map loads) and recycled when their system finishes,
+ * so a burst of hits doesn't allocate and register a new emitter each time.
+ */
+
+USTRUCT(BlueprintType)
+struct ACTIONCOMBAT_API FHitEffectPoolStats
+{
+	GENERATED_BODY()
+
+	// Requests served by an idle pooled component
+	UPROPERTY(BlueprintReadOnly)
+	int32 Hits{ 0 };
+
+	// Requests that had to create a new component
+	UPROPERTY(BlueprintReadOnly)
+	int32 Misses{ 0 };
+
+	// Requests that recycled the oldest playing component because the pool was full
+	UPROPERTY(BlueprintReadOnly)
+	int32 Evictions{ 0 };
+};
+
+UCLASS()
+class ACTIONCOMBAT_API UHitEffectPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FPoolKey
+	{
+		EHitEffectType Type;
+		const UParticleSystem* Template;
+
+		bool operator==(const FPoolKey& Other) const { return Type == Other.Type && Template == Other.Template; }
+
+		friend uint32 GetTypeHash(const FPoolKey& Key)
+		{
+			return HashCombine(::GetTypeHash(Key.Type), ::GetTypeHash(Key.Template));
+		}
+	};
+
+	struct FEffectPool
+	{
+		// Idle components ready to be reused
+		TArray<UParticleSystemComponent*> Free;
+
+		// Playing components, oldest first
+		TArray<UParticleSystemComponent*> Active;
+
+		int32 Capacity{ 0 };
+	};
+
+	TMap<FPoolKey, FEffectPool> Pools;
+
+	// Pool each component belongs to, used when its system finishes
+	TMap<const UParticleSystemComponent*, FPoolKey> ComponentKeys;
+
+	// Keeps every pooled component alive for the lifetime of the world
+	UPROPERTY()
+	TArray<TObjectPtr<UParticleSystemComponent>> PooledComponents;
+
+	FHitEffectPoolStats Stats;
+
+	// Max components per effect unless a prewarm asks for more
+	static constexpr int32 DefaultCapacity{ 8 };
+
+	FEffectPool& FindOrAddPool(const FPoolKey& Key);
+
+	UParticleSystemComponent* CreateComponent(const FPoolKey& Key, UParticleSystem* Template);
+
+	UFUNCTION()
+	void HandleSystemFinished(UParticleSystemComponent* FinishedComponent);
+
+public:
+	virtual void Deinitialize() override;
+
+	// Creates idle components for an effect up front and raises its capacity to at least Count
+	void Prewarm(EHitEffectType Type, UParticleSystem* Template, int32 Count);
+
+	// Plays an effect at a location using a pooled component
+	UParticleSystemComponent* SpawnEffect(
+		EHitEffectType Type,
+		UParticleSystem* Template,
+		const FVector& Location,
+		const FRotator& Rotation = FRotator::ZeroRotator
+	);
+
+	UFUNCTION(BlueprintPure)
+	FHitEffectPoolStats GetStats() const { return Stats; }
+};
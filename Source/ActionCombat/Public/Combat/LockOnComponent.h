@@ -17,6 +17,17 @@ DECLARE_DYNAMIC_MULTICAST_SPARSE_DELEGATE_OneParam(
 	AActor*, NewTargetActorRef
 );
 
+// Enemy considered for lock-on, with the values it was scored by
+struct FLockOnCandidate
+{
+	TWeakObjectPtr<AActor> Actor;
+	// Angle between the camera's forward vector and the direction to the enemy, in degrees
+	float ViewAngle{ 0.0f };
+	// Horizontal angle from the center of the view, negative to the left
+	float ScreenYaw{ 0.0f };
+	float Distance{ 0.0f };
+	float Score{ 0.0f };
+};
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class ACTIONCOMBAT_API ULockOnComponent : public UActorComponent
@@ -32,6 +43,63 @@ private:
 	class UCharacterMovementComponent* MovementComp;
 	// Reference to the character's spring arm (camera boom)
 	class USpringArmComponent* SpringArmComp;
+	// Source of nearby enemies, avoids a physics query per lock-on press
+	class UFighterRegistrySubsystem* FighterRegistry{ nullptr };
+
+	// Candidates to switch between while locked on, sorted left to right by screen yaw
+	TArray<FLockOnCandidate> SwitchCandidates;
+
+	FTimerHandle SwitchCandidatesTimerHandle;
+
+	// Radius the current lock-on was started with
+	float LockOnRadius{ 0.0f };
+
+	// Mesh and socket of the current target the camera aims at, cached when the target changes
+	TWeakObjectPtr<class USkeletalMeshComponent> TargetAimMesh;
+	FName TargetAimSocket;
+
+	// Async line of sight checks of the current target
+	class ULockOnVisibilitySubsystem* VisibilitySubsystem{ nullptr };
+
+	// Set by a blocked line of sight result and cleared by a clear one
+	bool bTargetOccluded{ false };
+	double OccludedSinceTime{ 0.0 };
+
+	// Enemies around the owner for soft targeting, regathered only once the cache is stale
+	TArray<TWeakObjectPtr<AActor>> NearbyEnemies;
+	double NearbyEnemiesTime{ -UE_BIG_NUMBER };
+	float NearbyEnemiesRadius{ 0.0f };
+
+	// Pitch and yaw speed of the lock-on camera spring
+	FRotator CameraRotationVelocity{ ForceInitToZero };
+
+	void CacheTargetAimPoint();
+
+	FVector GetTargetAimLocation() const;
+
+	// Aim point of any enemy without the cache, used for line of sight before it becomes the target
+	FVector ComputeAimLocation(const AActor* Target) const;
+
+	// Fills in the angles and score of the candidate, false if it is too far off screen to target
+	bool EvaluateCandidate(FLockOnCandidate& Candidate, const FVector& ViewLocation,
+		const FRotator& ViewRotation, float Radius) const;
+
+	// Fills OutCandidates with every enemy in radius, best score first
+	void GatherCandidates(float Radius, TArray<FLockOnCandidate>& OutCandidates) const;
+
+	// Best visible candidate, only the top few candidates are traced for line of sight
+	AActor* FindBestTarget(float Radius) const;
+
+	bool HasLineOfSight(const AActor* Target) const;
+
+	// Updates the switch candidates in place from the fighter registry, runs on a timer while locked on
+	void RefreshSwitchCandidates();
+
+	// Ends the lock-on after its target was destroyed
+	void ReleaseLostTarget();
+
+	// Moves the lock-on to the next candidate on the given side of the current target
+	void SwitchTarget(bool bRight);
 
 public:	
 	// Sets default values for this component's properties
@@ -46,6 +114,15 @@ public:
 
 	// Ends the current lock-on
 	void EndLockOn();
+
+	// Camera to aim point segment of the current target, false when not locked on
+	bool GetLineOfSightTrace(FVector& OutStart, FVector& OutEnd) const;
+
+	// Called by the visibility subsystem when a line of sight check of Target completes
+	void HandleLineOfSightResult(const AActor* Target, bool bVisible);
+
+	// Best enemy within Range and ConeAngle degrees of the owner's facing, for aim assist without a hard lock
+	AActor* FindSoftTarget(float Range, float ConeAngle);
 	
 protected:
 	// Called when the game starts
@@ -60,10 +137,53 @@ protected:
 	UFUNCTION(BlueprintCallable)
 	void ToggleLockOn(float Radius = 1000.0f);
 
+	// Switch the lock-on to the closest enemy left or right of the current target
+	UFUNCTION(BlueprintCallable)
+	void SwitchTargetLeft() { SwitchTarget(false); }
+
+	UFUNCTION(BlueprintCallable)
+	void SwitchTargetRight() { SwitchTarget(true); }
+
+	// Seconds between updates of the target switching list
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.05"))
+	float SwitchCandidatesRefreshInterval { 0.25f };
+
 	//  lock-on max distance which is automatically broken when exceeded
 	UPROPERTY(EditAnywhere)
 	double BreakDistance { 1000.0 };
 
+	// Seconds the target has to stay hidden before the lock-on breaks, so passing pillars don't break it
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float OcclusionBreakDelay { 1.0f };
+
+	// Time the lock-on camera takes to settle on the target, lower is snappier
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.01"))
+	float CameraSmoothingTime { 0.2f };
+
+	// Aim point relative to the origin of targets without an aim socket
+	UPROPERTY(EditAnywhere)
+	FVector FallbackAimOffset { 0.0, 0.0, -125.0 };
+
+	// Enemies further than this from the center of the view can't be acquired
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0", ClampMax = "180.0"))
+	float MaxTargetAngle { 70.0f };
+
+	// How much being close counts when picking a target
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float DistanceWeight { 1.0f };
+
+	// How much being near the center of the view counts when picking a target
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float AngleWeight { 2.0f };
+
+	// Seconds the soft targeting enemy list is reused before it is gathered again
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0.0"))
+	float SoftTargetCacheLifetime { 0.5f };
+
+	// Line of sight traces allowed per acquisition, tried from the best scored candidate down
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "1"))
+	int32 MaxLineOfSightChecks { 3 };
+
 
 
 
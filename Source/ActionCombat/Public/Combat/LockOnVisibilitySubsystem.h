@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "LockOnVisibilitySubsystem.generated.h"
+
+class ULockOnComponent;
+
+/**
+ * Checks whether locked-on targets are still visible with async line traces.
+ * Watchers are served round-robin from a world-wide trace budget, so the traces issued per second
+ * stay bounded no matter how many lock-on components are active.
+ */
+UCLASS()
+class ACTIONCOMBAT_API ULockOnVisibilitySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FVisibilityWatcher
+	{
+		TWeakObjectPtr<ULockOnComponent> Component;
+		// Target the in-flight trace was issued for
+		TWeakObjectPtr<AActor> TracedTarget;
+		double LastCheckTime{ -UE_BIG_NUMBER };
+		bool bTracePending{ false };
+	};
+
+	// Sparse so indices passed through the traces stay valid when watchers leave
+	TSparseArray<FVisibilityWatcher> Watchers;
+
+	FTraceDelegate TraceDelegate;
+
+	// Traces allowed but not issued yet, refilled every frame
+	float TraceBudget{ 0.0f };
+
+	// Where the round-robin continues next frame
+	int32 NextWatcherIndex{ 0 };
+
+	// Line of sight traces per second across every watcher
+	static constexpr float MaxTracesPerSecond{ 30.0f };
+
+	// Shortest time between two checks of the same watcher
+	static constexpr double MinCheckInterval{ 0.1 };
+
+	void OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	void IssueTrace(int32 WatcherIndex);
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Starts periodic line of sight checks for the component's current target
+	void AddWatcher(ULockOnComponent* Component);
+	void RemoveWatcher(ULockOnComponent* Component);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+};
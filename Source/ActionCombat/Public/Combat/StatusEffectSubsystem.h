@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Combat/EStatusEffectType.h"
+#include "StatusEffectSubsystem.generated.h"
+
+class UStatsComponent;
+
+/**
+ * World-level manager of every active status effect (bleed, poison, stagger).
+ * Effects are stored as parallel arrays and ticked together in fixed pulses. Each pulse sorts the damaging
+ * effects by target, sums their damage into flat per-target scratch arrays and applies it with one ReduceHealth
+ * call per target, with no per-effect objects and no hashing.
+ * Applying Stagger interrupts the target's current attack.
+ */
+UCLASS()
+class ACTIONCOMBAT_API UStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	// One entry per active effect, the same index across every array
+	TArray<TWeakObjectPtr<UStatsComponent>> Targets;
+	TArray<EStatusEffectType> Types;
+	TArray<float> DamagePerSecond;
+	TArray<float> RemainingTime;
+
+	// Per-pulse scratch, kept around so the allocations are reused: damaging effects sorted by target,
+	// then each distinct target with the damage summed over its effects
+	TArray<int32> PulseOrder;
+	TArray<TWeakObjectPtr<UStatsComponent>> PulseTargets;
+	TArray<float> PulseDamage;
+
+	float TimeSinceLastPulse{ 0.0f };
+
+	// Seconds between damage pulses
+	static constexpr float PulseInterval{ 0.1f };
+
+	int32 FindEffect(const UStatsComponent* Target, EStatusEffectType Type) const;
+
+	void RemoveEffectAt(int32 Index);
+
+	// Stops whatever attack or action montage the target is playing
+	static void InterruptTarget(AActor* Target);
+
+public:
+	// Applies the effect, or refreshes it if the target already has one of this type
+	UFUNCTION(BlueprintCallable)
+	void ApplyStatusEffect(AActor* Target, EStatusEffectType Type, float Duration, float EffectDamagePerSecond);
+
+	// Ends every effect of this type on the target
+	UFUNCTION(BlueprintCallable)
+	void ClearStatusEffect(AActor* Target, EStatusEffectType Type);
+
+	UFUNCTION(BlueprintPure)
+	bool HasStatusEffect(const AActor* Target, EStatusEffectType Type) const;
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumActiveEffects() const { return Types.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+};
@@ -5,18 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Combat/FTraceSockets.h"
+#include "Combat/EHitEffectType.h"
+#include "Combat/EBodyZone.h"
+#include "Combat/EStatusEffectType.h"
+#include "Combat/TraceRecording.h"
+#include "WorldCollision.h"
 #include "TraceComponent.generated.h"
 
 
-UENUM(BlueprintType)
-enum class EHitEffectType : uint8
-{
-	Normal  UMETA(DisplayName = "Normal Hit"),
-	Block   UMETA(DisplayName = "Block"),
-	Parry   UMETA(DisplayName = "Parry")
-};
-
-
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class ACTIONCOMBAT_API UTraceComponent : public UActorComponent
 {
@@ -27,6 +23,12 @@ private:
 
 	UPROPERTY(EditAnywhere)
 	TArray<FTraceSockets> Sockets;
+
+	// Sockets resolved to bone indices (one entry per socket), rebuilt when the mesh changes
+	TArray<FResolvedTraceSockets> ResolvedSockets;
+
+	// Mesh the resolved sockets were built for
+	TWeakObjectPtr<const USkinnedAsset> ResolvedMesh;
 	
 	// Length of the box collision (width/depth is constant)
 	UPROPERTY(EditAnywhere)
@@ -36,6 +38,47 @@ private:
 	UPROPERTY(EditAnywhere)
 	bool bDebugMode { false };
 
+	// Sweeps interpolated poses between the previous and current frame so fast swings can't skip targets
+	UPROPERTY(EditAnywhere, Category = "Sub-Stepping")
+	bool bUseSubSteps { true };
+
+	// Upper bound of sweeps per socket per frame when sub-stepping
+	UPROPERTY(EditAnywhere, Category = "Sub-Stepping", meta = (EditCondition = "bUseSubSteps", ClampMin = "1", ClampMax = "16"))
+	int32 MaxSubSteps { 4 };
+
+	// Arc (in degrees) a single sub-step may cover; 0 always uses MaxSubSteps
+	UPROPERTY(EditAnywhere, Category = "Sub-Stepping", meta = (EditCondition = "bUseSubSteps", ClampMin = "0.0"))
+	float MaxSubStepAngle { 15.0f };
+
+	// Socket poses sampled on the last traced frame (one entry per socket)
+	TArray<FTraceSocketPose> PreviousPoses;
+
+	// Skips sweeps whose swept bounds don't touch any registered fighter
+	UPROPERTY(EditAnywhere)
+	bool bUseFighterPrefilter { true };
+
+	class UFighterRegistrySubsystem* FighterRegistry { nullptr };
+
+	// Issues sweeps through the async scene query queue, hits are applied one frame later
+	UPROPERTY(EditAnywhere, Category = "Async")
+	bool bUseAsyncTrace { false };
+
+	// Completion callback shared by every async sweep this component issues
+	FTraceDelegate AsyncTraceDelegate;
+
+	// Async sweeps issued but not yet completed
+	int32 NumPendingAsyncTraces { 0 };
+
+	// Set when the attack ended while sweeps were still in flight
+	bool bResetAfterPendingTraces { false };
+
+	// Increases with every attack window, async sweeps carry it so late results of an older window are dropped
+	uint32 AttackWindowIndex { 0 };
+
+	// Whether the character is currently inside an attack window (the component only ticks while true)
+	UPROPERTY(VisibleAnywhere)
+	bool bIsAttacking { false };
+
 	// List of actors already hit during this attack to avoid duplicates
 	TArray<AActor*> TargetsToIgnore;
 
@@ -48,19 +91,79 @@ private:
 	UPROPERTY(EditAnywhere)
 	UParticleSystem* ParryParticleTemplate;
 
+	// Replaces the normal hit effect for specific body zones (e.g. a weak point burst on the head)
+	UPROPERTY(EditAnywhere)
+	TMap<EBodyZone, UParticleSystem*> ZoneHitParticleTemplates;
+
+	// Bleed, poison or stagger left by the weapon's undefended hits
+	UPROPERTY(EditAnywhere)
+	FStatusEffectOnHit StatusEffectOnHit;
+
+	// Shared by every hit of the current attack window
+	int32 CurrentAttackId{ INDEX_NONE };
 
-	// Helper function to spawn appropriate hit effect
-	void SpawnHitEffect(const FVector& Location, EHitEffectType HitType);
+	// Effects of each type created up front in the world's hit effect pool
+	UPROPERTY(EditAnywhere, meta = (ClampMin = "0"))
+	int32 HitEffectPrewarmCount { 4 };
+
+	// Captures the poses of every traced frame while true
+	bool bIsRecording { false };
+	double RecordingStartTime { 0.0 };
+	FTraceRecording Recording;
+
+	// Index of each fighter in Recording.Targets
+	TMap<const AActor*, int32> RecordedTargetIndices;
+
+	// Set while replaying, hits are counted here instead of being sent to the damage pass
+	FTraceReplayReport* ActiveReplayReport { nullptr };
+
+	// Stand-ins for the recorded targets while replaying, only hits on these are counted
+	TArray<AActor*> ReplayTargets;
+
+	// Live fighters kept out of the replay's sweeps
+	TArray<AActor*> ReplayIgnoredActors;
+
+
+	// Resolves socket names to bone indices if the mesh changed since the last resolve
+	void ResolveSockets();
+
+	// Reads the current world-space pose of every socket pair
+	void GatherSocketPoses(TArray<FTraceSocketPose>& OutPoses) const;
+
+	// Appends the socket poses and the fighters around them to the recording
+	void RecordFrame(const TArray<FTraceSocketPose>& Poses);
+
+	// Spawns a capsule stand-in per recorded target and hides the live fighters from the replay
+	void BeginReplayScene(const FTraceRecording& InRecording);
+
+	// Moves the stand-ins to where their targets stood on the frame
+	void PlaceReplayTargets(const FTraceRecordingFrame& Frame);
+
+	void EndReplayScene();
+
+	// Sweeps the current poses (sub-stepping from the previous ones) and processes the hits
+	void TracePoses(TArray<FTraceSocketPose>&& CurrentPoses);
+
+	// Number of sweeps needed to cover the motion between two poses
+	int32 GetSubStepCount(const FTraceSocketPose& From, const FTraceSocketPose& To) const;
+
+	// Sweeps the weapon box for one pose, returns true if anything was hit
+	// In async mode the sweep is only queued and this always returns false
+	bool SweepPose(const FTraceSocketPose& Pose, TArray<FHitResult>& OutResults);
+
+	// Receives the results of an async sweep issued on the previous frame
+	void OnAsyncTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	void DrawDebugSweep(const FVector& Start, const FVector& End, const FQuat& Rotation, const FVector& HalfExtent, bool bHit) const;
+
+	// Queues every hit actor that wasn't already hit this attack for the end-of-frame damage pass
+	void ProcessHits(const TArray<FHitResult>& Hits);
 
 	
 public:	
 	// Sets default values for this component's properties
 	UTraceComponent();
 
-	// Whether the character is currently attacking (triggers trace in Tick)
-	UPROPERTY(VisibleAnywhere)
-	bool bIsAttacking { false };
-
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
@@ -74,6 +177,28 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void HandleResetAttack();
 
+	// Opens or closes the attack window, closing it stops the tick and resets the hit targets
+	UFUNCTION(BlueprintCallable)
+	void SetAttackWindowActive(bool bActive);
+
+	bool IsAttacking() const { return bIsAttacking; }
+
+	// Helper function to spawn appropriate hit effect
+	void SpawnHitEffect(const FVector& Location, EHitEffectType HitType, EBodyZone Zone = EBodyZone::Default);
+
+	// Starts capturing the socket poses of every attack window
+	UFUNCTION(BlueprintCallable)
+	void StartTraceRecording();
+
+	// Stops capturing and writes the recording to disk
+	UFUNCTION(BlueprintCallable)
+	bool StopTraceRecording(const FString& FilePath);
+
+	// Feeds recorded poses through the same sweep and dedup code as live play without applying damage.
+	// Recorded targets are stood in for by capsules and live fighters are ignored, so the report only
+	// depends on the recording (and on any static geometry in the world it runs in)
+	void ReplayRecording(const FTraceRecording& InRecording, FTraceReplayReport& OutReport);
+
 	
 			
 };
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/LineBatchComponent.h"
+#include "TraceDebugSubsystem.generated.h"
+
+/**
+ * Debug draw layer for weapon traces.
+ * Sweeps and hits from every trace component go into ring buffers, and once per frame the shapes of the last
+ * few seconds are turned into lines and handed to the world line batcher in a single push.
+ * The buffers are sized to hold the last HistorySeconds at the expected sweep rate, above that rate the oldest
+ * shapes are overwritten sooner and the history gets shorter.
+ * The view can be frozen and scrubbed back through the buffered history (see ActionCombat.TraceDebug.* commands),
+ * nothing is recorded while frozen so the history being inspected stays intact.
+ */
+UCLASS()
+class ACTIONCOMBAT_API UTraceDebugSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FSweepShape
+	{
+		double Time{ 0.0 };
+		FVector Center{ FVector::ZeroVector };
+		FVector HalfExtent{ FVector::ZeroVector };
+		FQuat Rotation{ FQuat::Identity };
+		bool bHit{ false };
+	};
+
+	struct FHitMarker
+	{
+		double Time{ 0.0 };
+		FVector Location{ FVector::ZeroVector };
+	};
+
+	// Fixed-size ring buffers, the oldest entries are overwritten once full
+	TArray<FSweepShape> Sweeps;
+	int32 NextSweep{ 0 };
+
+	TArray<FHitMarker> Hits;
+	int32 NextHit{ 0 };
+
+	// Reused every frame for the batched line push
+	TArray<FBatchedLine> Lines;
+
+	// Seconds of history kept for scrubbing, older shapes are never drawn
+	static constexpr double HistorySeconds{ 5.0 };
+
+	// Rates the buffers are sized for, roughly ten fighters with two sub-stepped sockets at 60 fps
+	static constexpr int32 ExpectedSweepsPerSecond{ 2400 };
+	static constexpr int32 ExpectedHitsPerSecond{ 100 };
+
+	static constexpr int32 MaxSweeps{ static_cast<int32>(HistorySeconds * ExpectedSweepsPerSecond) };
+	static constexpr int32 MaxHits{ static_cast<int32>(HistorySeconds * ExpectedHitsPerSecond) };
+
+	// Seconds of history drawn around the viewed time
+	float DisplaySeconds{ 1.0f };
+
+	bool bFrozen{ false };
+	double FrozenTime{ 0.0 };
+
+	// How far behind the frozen time the view is
+	double ScrubSeconds{ 0.0 };
+
+	void AddBoxLines(const FSweepShape& Shape, const FLinearColor& Color);
+	void AddHitLines(const FHitMarker& Hit, const FLinearColor& Color);
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	void AddSweep(const FVector& Start, const FVector& End, const FQuat& Rotation, const FVector& HalfExtent, bool bHit);
+	void AddHit(const FVector& Location);
+
+	// Stops advancing the view so the buffered history can be inspected
+	void SetFrozen(bool bInFrozen);
+	bool IsFrozen() const { return bFrozen; }
+
+	// Moves the frozen view back in time (clamped to the kept history)
+	void SetScrub(double SecondsBack) { ScrubSeconds = FMath::Clamp(SecondsBack, 0.0, HistorySeconds); }
+
+	void SetDisplaySeconds(float Seconds) { DisplaySeconds = FMath::Max(Seconds, 0.0f); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+};
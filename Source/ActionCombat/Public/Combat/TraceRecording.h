@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Combat/FTraceSockets.h"
+
+/*
+ *	Compact binary capture of the socket poses a UTraceComponent swept, used to replay
+ *	hit registration without playing the game (see UTraceComponent::ReplayRecording)
+ */
+
+// Collision stand-in for a fighter that was near the weapon while recording
+struct ACTIONCOMBAT_API FTraceRecordedTarget
+{
+	// Name of the actor it was captured from, only used in reports
+	FString Name;
+
+	float CapsuleRadius{ 0.0f };
+	float CapsuleHalfHeight{ 0.0f };
+};
+
+// Where a recorded target stood on one frame
+struct ACTIONCOMBAT_API FTraceRecordedTargetPose
+{
+	// Index into FTraceRecording::Targets
+	int32 TargetIndex{ INDEX_NONE };
+
+	FVector Location{ FVector::ZeroVector };
+	FQuat Rotation{ FQuat::Identity };
+};
+
+// One traced frame of an attack window
+struct ACTIONCOMBAT_API FTraceRecordingFrame
+{
+	// Seconds since the recording started
+	float Time{ 0.0f };
+
+	// First frame of an attack window (the hit targets were reset before it)
+	bool bWindowStart{ false };
+
+	// One pose per socket pair
+	TArray<FTraceSocketPose> Poses;
+
+	// Recorded targets present on this frame, the others are out of reach
+	TArray<FTraceRecordedTargetPose> Targets;
+};
+
+struct ACTIONCOMBAT_API FTraceRecording
+{
+	// Name of the actor the recording was captured from
+	FString OwnerName;
+
+	TArray<FTraceRecordedTarget> Targets;
+
+	TArray<FTraceRecordingFrame> Frames;
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	// Fails on truncated or corrupt data instead of trusting the counts stored in it
+	bool LoadFromBytes(const TArray<uint8>& Bytes);
+
+	// Default location for recordings of the given owner
+	static FString GetDefaultFilePath(const FString& RecordingName);
+
+	// Trace component of the actor the recording was captured from, nullptr if it isn't in the world
+	class UTraceComponent* FindRecordedTraceComponent(UWorld* World) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FTraceRecording& Recording);
+};
+
+// Results of replaying a recording through a trace component
+struct ACTIONCOMBAT_API FTraceReplayReport
+{
+	int32 Frames{ 0 };
+	int32 Windows{ 0 };
+
+	// Unique recorded targets hit, counted once per attack window like live play
+	int32 Hits{ 0 };
+
+	// Physics sweeps run and sweeps skipped by the fighter registry
+	int32 Sweeps{ 0 };
+	int32 SkippedSweeps{ 0 };
+
+	double TotalMs{ 0.0 };
+	double MaxFrameMs{ 0.0 };
+
+	double GetAverageFrameMs() const { return Frames > 0 ? TotalMs / Frames : 0.0; }
+};
@@ -27,4 +27,7 @@ public:
 
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnDeselect();
+
+	// Socket on the enemy's mesh the lock-on camera aims at, NAME_None uses the lock-on's fallback offset
+	virtual FName GetLockOnAimSocket() const { return NAME_None; }
 };
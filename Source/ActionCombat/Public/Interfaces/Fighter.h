@@ -35,4 +35,15 @@ public:
 	virtual bool IsBlocking() const = 0;
 	virtual bool IsParrying() const = 0;
 	virtual bool IsBlockFailed() const { return false; }
+
+	// Locational damage setup of this fighter's mesh, nullptr deals the same damage everywhere
+	virtual const class UBodyZoneTable* GetBodyZoneTable() const { return nullptr; }
+
+	// Works out how an attack lands on this fighter (evaded, parried, blocked) and the damage left after it.
+	// Called once per hit by FDamageResolver, OutResolution starts as the full damage applied.
+	// By default a hit CanTakeDamage refuses is evaded
+	virtual void ResolveIncomingDamage(const struct FCombatDamageEvent& DamageEvent, AActor* Attacker,
+		struct FDamageResolution& OutResolution);
+
+	virtual class UStatsComponent* GetStatsComponent() const { return nullptr; }
 };
\ No newline at end of file